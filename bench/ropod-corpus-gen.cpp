@@ -0,0 +1,151 @@
+//  Writes a corpus of generated ropod messages for load and regression tests. Build it like
+//  the benchmark:
+//
+//     g++ -std=c++14 -O2 -DNDEBUG -Isrc/cpp -pthread bench/ropod-corpus-gen.cpp -o ropod-corpus-gen
+//
+//  then, for instance,
+//
+//     ./ropod-corpus-gen --root RopodTaskSchema --actions 1-500:log --count 10000 > tasks.jsonl
+//     ./ropod-corpus-gen --root RopodRobotPose2DSchema --robots 1000 --count 1000000 --format packed --out poses.bin
+//     ./ropod-corpus-gen --root RopodComponentMonitorSchema --json-depth 2-5 --count 10000 > health.jsonl
+//
+//  --root may be given several times, as NAME or NAME:WEIGHT, to mix root classes. Sizes are
+//  N, MIN-MAX (uniform) or MIN-MAX:log (log-uniform). --optionals and --debug-geometry are
+//  the probability that a message sets its optional members and its debug geometry. Every
+//  message passes check_constraints; the same arguments give the same corpus.
+
+#include "ropod-message-generator.cpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    using namespace quicktype;
+
+    struct Root {
+        const char * name;
+        void (*add)(CorpusGenerator &, double);
+    };
+
+    const Root roots[] = {
+        { "RopodBlackBoxDataQuerySchema", [](CorpusGenerator & g, double w) { g.add<RopodBlackBoxDataQuerySchema>(w); } },
+        { "RopodBlackBoxLatestDataQuerySchema", [](CorpusGenerator & g, double w) { g.add<RopodBlackBoxLatestDataQuerySchema>(w); } },
+        { "RopodBlackBoxLoggingCmdSchema", [](CorpusGenerator & g, double w) { g.add<RopodBlackBoxLoggingCmdSchema>(w); } },
+        { "RopodBlackBoxVariableQuerySchema", [](CorpusGenerator & g, double w) { g.add<RopodBlackBoxVariableQuerySchema>(w); } },
+        { "RopodCmdSchema", [](CorpusGenerator & g, double w) { g.add<RopodCmdSchema>(w); } },
+        { "RopodComponentMonitorSchema", [](CorpusGenerator & g, double w) { g.add<RopodComponentMonitorSchema>(w); } },
+        { "RopodElevatorCmdSchema", [](CorpusGenerator & g, double w) { g.add<RopodElevatorCmdSchema>(w); } },
+        { "RopodElevatorStatusSchema", [](CorpusGenerator & g, double w) { g.add<RopodElevatorStatusSchema>(w); } },
+        { "RopodExperimentCancel", [](CorpusGenerator & g, double w) { g.add<RopodExperimentCancel>(w); } },
+        { "RopodExperimentRequest", [](CorpusGenerator & g, double w) { g.add<RopodExperimentRequest>(w); } },
+        { "RopodExperimentSmSchema", [](CorpusGenerator & g, double w) { g.add<RopodExperimentSmSchema>(w); } },
+        { "RopodFmsElevatorSchema", [](CorpusGenerator & g, double w) { g.add<RopodFmsElevatorSchema>(w); } },
+        { "RopodMsgSchema", [](CorpusGenerator & g, double w) { g.add<RopodMsgSchema>(w); } },
+        { "RopodRobotPose2DSchema", [](CorpusGenerator & g, double w) { g.add<RopodRobotPose2DSchema>(w); } },
+        { "RopodTaskRequestSchema", [](CorpusGenerator & g, double w) { g.add<RopodTaskRequestSchema>(w); } },
+        { "RopodTaskSchema", [](CorpusGenerator & g, double w) { g.add<RopodTaskSchema>(w); } },
+        { "RopodUnitsSchema", [](CorpusGenerator & g, double w) { g.add<RopodUnitsSchema>(w); } }
+    };
+
+    int usage(const char * program) {
+        std::cerr << "usage: " << program << " --root NAME[:WEIGHT]... [--count N] [--seed N] [--format ndjson|packed] [--out FILE]\n"
+                  << "       [--receivers SIZE] [--actions SIZE] [--list-length SIZE] [--json-depth SIZE]\n"
+                  << "       [--optionals P] [--debug-geometry P] [--robots N]\n"
+                  << "SIZE is N, MIN-MAX or MIN-MAX:log. Root classes:\n";
+        for (const Root & root : roots) std::cerr << "  " << root.name << "\n";
+        return 2;
+    }
+
+    bool parse_size(const std::string & text, SizeDistribution & size) {
+        std::string range = text;
+        SizeScale scale = SizeScale::UNIFORM;
+        const size_t colon = range.find(':');
+        if (colon != std::string::npos) {
+            if (range.substr(colon + 1) != "log") return false;
+            scale = SizeScale::LOG_UNIFORM;
+            range.resize(colon);
+        }
+        char * end = nullptr;
+        const size_t min = std::strtoull(range.c_str(), &end, 10);
+        if (end == range.c_str()) return false;
+        if (*end == '\0') {
+            size = SizeDistribution(min);
+            return colon == std::string::npos;
+        }
+        if (*end != '-') return false;
+        const char * max_text = end + 1;
+        const size_t max = std::strtoull(max_text, &end, 10);
+        if (end == max_text || *end != '\0') return false;
+        size = SizeDistribution(min, max, scale);
+        return true;
+    }
+}
+
+int main(int argc, char ** argv) {
+    CorpusOptions options;
+    std::vector<std::pair<const Root *, double>> picked;
+    size_t count = 1000;
+    uint64_t seed = 1;
+    CorpusFormat format = CorpusFormat::NDJSON;
+    std::string out_path;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) return usage(argv[0]);
+        const std::string value = argv[++i];
+        SizeDistribution size;
+        if (arg == "--root") {
+            const size_t colon = value.find(':');
+            const std::string name = value.substr(0, colon);
+            const Root * root = nullptr;
+            for (const Root & r : roots) {
+                if (name == r.name) root = &r;
+            }
+            if (root == nullptr) return usage(argv[0]);
+            picked.emplace_back(root, colon == std::string::npos ? 1.0 : std::atof(value.c_str() + colon + 1));
+        } else if (arg == "--count") {
+            count = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--seed") {
+            seed = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--format" && (value == "ndjson" || value == "packed")) {
+            format = value == "ndjson" ? CorpusFormat::NDJSON : CorpusFormat::PACKED;
+        } else if (arg == "--out") {
+            out_path = value;
+        } else if (arg == "--receivers" && parse_size(value, size)) {
+            options.set_receivers(size);
+        } else if (arg == "--actions" && parse_size(value, size)) {
+            options.set_actions(size);
+        } else if (arg == "--list-length" && parse_size(value, size)) {
+            options.set_list_length(size);
+        } else if (arg == "--json-depth" && parse_size(value, size)) {
+            options.set_json_depth(size);
+        } else if (arg == "--optionals") {
+            options.set_optionals(std::atof(value.c_str()));
+        } else if (arg == "--debug-geometry") {
+            options.set_debug_geometry(std::atof(value.c_str()));
+        } else if (arg == "--robots") {
+            options.set_robots(std::strtoull(value.c_str(), nullptr, 10));
+        } else {
+            return usage(argv[0]);
+        }
+    }
+    if (picked.empty()) return usage(argv[0]);
+
+    CorpusGenerator corpus(seed, options);
+    for (const auto & root : picked) root.first->add(corpus, root.second);
+
+    std::ofstream file;
+    if (!out_path.empty()) {
+        file.open(out_path, std::ios::binary);
+        if (!file) {
+            std::cerr << "cannot write " << out_path << std::endl;
+            return 1;
+        }
+    }
+    std::ostream & out = out_path.empty() ? std::cout : file;
+    const size_t bytes = corpus.write(out, count, format);
+    out.flush();
+    std::cerr << count << " messages, " << bytes << " bytes" << std::endl;
+    return out ? 0 : 1;
+}
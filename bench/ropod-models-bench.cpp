@@ -0,0 +1,414 @@
+//  Benchmarks encoding, decoding and validating every root class of src/cpp on generated
+//  messages of several shapes. Build it with the include paths of nlohmann/json and Boost:
+//
+//     g++ -std=c++14 -O2 -DNDEBUG -Isrc/cpp -pthread bench/ropod-models-bench.cpp -o ropod-models-bench
+//
+//  and run it from anywhere:
+//
+//     ./ropod-models-bench [--filter TEXT] [--min-time MS] [--seed N] [--max-threads N] > results.jsonl
+//
+//  Each case prints one JSON object per line: its name (root/shape/operation), the root, the
+//  shape, the operation, the mean size of the encoded messages, the number of iterations, and
+//  the time per operation and throughput. encode is quicktype::encode, decode is
+//  quicktype::try_decode from JSON text, validate is quicktype::check_constraints on a decoded
+//  message. The Msgpack/... and Cbor/... cases encode and decode the same messages with
+//  encode_msgpack/decode_msgpack and encode_cbor/decode_cbor, with the size of the binary form.
+//  The RopodRobotPose2DSchema/precision=... cases encode, emit and decode pose messages with
+//  coordinates rounded to the millimetre and at full precision, in both DoubleNotations. The
+//  RopodElevatorStatusSchema/malformed=... cases time rejecting malformed messages with
+//  try_decode, with decode and a catch, and with json::parse and get and a catch. The
+//  Message/batch=... cases time decode_batch on a mixed recording from 1 thread up to
+//  --max-threads, one per core by default. The Instant cases compare Instant::format with
+//  InstantFormatter on date-time time stamps. --filter runs only the cases whose name contains
+//  TEXT; --min-time is the time each case runs for, 200 ms by default. Add
+//  -DQUICKTYPE_INLINE_OPTIONALS to measure inline optionals.
+
+#include "ropod-message-generator.cpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+namespace {
+    using namespace quicktype;
+
+    // distinct messages each case cycles through
+    const size_t messages_per_case = 16;
+
+    volatile size_t sink;
+
+    struct Options {
+        std::string filter;
+        double min_time_ms = 200;
+        uint64_t seed = 1;
+        size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    };
+
+    std::string shape_name(const MessageShape & shape) {
+        return "receivers=" + std::to_string(shape.get_receivers()) +
+            ",actions=" + std::to_string(shape.get_actions()) +
+            ",debug=" + (shape.get_debug_geometry() ? "on" : "off") +
+            ",optionals=" + (shape.get_optionals() ? "on" : "off");
+    }
+
+    /**
+     * Calls op(i) for i = 0, 1, ... until min_time_ms have passed, doubling the number of
+     * calls between clock reads. Returns the time per call in nanoseconds.
+     */
+    template <typename Op>
+    double measure(const Op & op, double min_time_ms, size_t & iterations) {
+        using clock = std::chrono::steady_clock;
+        for (size_t i = 0; i < messages_per_case; i++) op(i);
+        iterations = 0;
+        size_t batch = 1;
+        const clock::time_point start = clock::now();
+        for (;;) {
+            for (size_t i = 0; i < batch; i++) op(iterations + i);
+            iterations += batch;
+            const double elapsed = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+            if (elapsed >= min_time_ms) return elapsed * 1e6 / static_cast<double>(iterations);
+            batch *= 2;
+        }
+    }
+
+    /**
+     * Runs the case name unless the filter excludes it and prints result with the name and
+     * the measurements added.
+     */
+    template <typename Op>
+    void run_case(const Options & options, const std::string & name, json result, const char * operation, double bytes, const Op & op) {
+        if (name.find(options.filter) == std::string::npos) return;
+        size_t iterations = 0;
+        const double ns = measure(op, options.min_time_ms, iterations);
+        result["name"] = name;
+        result["operation"] = operation;
+        result["bytes"] = bytes;
+        result["iterations"] = iterations;
+        result["nsPerOp"] = ns;
+        result["mbPerS"] = bytes * 1e3 / ns;
+        std::cout << result.dump() << std::endl;
+    }
+
+    json root_result(const char * root, const MessageShape & shape) {
+        json result;
+        result["root"] = root;
+        result["shape"] = {
+            {"receivers", shape.get_receivers()},
+            {"actions", shape.get_actions()},
+            {"debugGeometry", shape.get_debug_geometry()},
+            {"optionals", shape.get_optionals()}
+        };
+        return result;
+    }
+
+    template <typename Op>
+    void run_case(const Options & options, const char * root, const MessageShape & shape, const char * operation, double bytes, const Op & op) {
+        run_case(options, std::string(root) + "/" + shape_name(shape) + "/" + operation, root_result(root, shape), operation, bytes, op);
+    }
+
+    /**
+     * Encodes and decodes messages in a binary format as the Format/root/shape/encode and
+     * decode cases, whose size is that of the encoded messages.
+     */
+    template <typename T, typename Encode, typename Decode>
+    void run_binary(const Options & options, const char * format, const char * root, const MessageShape & shape, const std::vector<T> & messages, const Encode & encode_binary, const Decode & decode_binary) {
+        std::vector<std::vector<uint8_t>> encoded(messages.size());
+        double bytes = 0;
+        for (size_t i = 0; i < messages.size(); i++) {
+            encoded[i] = encode_binary(messages[i]);
+            bytes += static_cast<double>(encoded[i].size());
+        }
+        bytes /= static_cast<double>(messages.size());
+
+        const std::string name = std::string(format) + "/" + root + "/" + shape_name(shape) + "/";
+        json result = root_result(root, shape);
+        result["format"] = format;
+        run_case(options, name + "encode", result, "encode", bytes, [&](size_t i) {
+            sink = encode_binary(messages[i % messages.size()]).size();
+        });
+        run_case(options, name + "decode", result, "decode", bytes, [&](size_t i) {
+            const T x = decode_binary(encoded[i % messages.size()]);
+            sink = i;
+        });
+    }
+
+    template <typename T>
+    void run_root(const Options & options, const char * root, const std::vector<MessageShape> & shapes) {
+        for (const MessageShape & shape : shapes) {
+            MessageGenerator generator(options.seed, shape);
+            std::vector<T> messages(messages_per_case);
+            std::vector<std::string> texts(messages_per_case);
+            double bytes = 0;
+            for (size_t i = 0; i < messages_per_case; i++) {
+                generator.generate(messages[i]);
+                texts[i] = encode(messages[i]);
+                bytes += static_cast<double>(texts[i].size());
+            }
+            bytes /= messages_per_case;
+
+            run_case(options, root, shape, "encode", bytes, [&](size_t i) {
+                sink = encode(messages[i % messages_per_case]).size();
+            });
+            run_case(options, root, shape, "decode", bytes, [&](size_t i) {
+                sink = static_cast<bool>(try_decode<T>(texts[i % messages_per_case]));
+            });
+            run_case(options, root, shape, "validate", bytes, [&](size_t i) {
+                check_constraints(messages[i % messages_per_case]);
+                sink = i;
+            });
+            run_binary(options, "Msgpack", root, shape, messages,
+                [](const T & x) { return encode_msgpack(x); }, [](const std::vector<uint8_t> & bytes) { return decode_msgpack<T>(bytes); });
+            run_binary(options, "Cbor", root, shape, messages,
+                [](const T & x) { return encode_cbor(x); }, [](const std::vector<uint8_t> & bytes) { return decode_cbor<T>(bytes); });
+        }
+    }
+
+    /**
+     * Encodes and decodes pose messages, which are mostly doubles, with coordinates rounded
+     * to the millimetre and at full precision: with encode and the template emitter, in
+     * DoubleNotation::DUMP and SHORTEST.
+     */
+    void run_pose_numbers(const Options & options) {
+        for (bool full : {false, true}) {
+            MessageGenerator generator(options.seed);
+            std::mt19937_64 random(options.seed);
+            std::vector<RopodRobotPose2DSchema> messages(messages_per_case);
+            std::vector<std::string> texts(messages_per_case);
+            double bytes = 0;
+            for (size_t i = 0; i < messages_per_case; i++) {
+                generator.generate(messages[i]);
+                if (full) {
+                    Pose2D & pose = messages[i].get_mutable_payload().get_mutable_pose();
+                    pose.set_x(std::uniform_real_distribution<double>(-100, 100)(random));
+                    pose.set_y(std::uniform_real_distribution<double>(-100, 100)(random));
+                    pose.set_theta(std::uniform_real_distribution<double>(-3.15, 3.15)(random));
+                }
+                texts[i] = encode(messages[i]);
+                bytes += static_cast<double>(texts[i].size());
+            }
+            bytes /= messages_per_case;
+
+            const std::string precision = full ? "full" : "mm";
+            json result;
+            result["root"] = "RopodRobotPose2DSchema";
+            result["shape"] = {{"precision", precision}};
+            for (DoubleNotation notation : {DoubleNotation::DUMP, DoubleNotation::SHORTEST}) {
+                const std::string suffix = notation == DoubleNotation::DUMP ? "dump" : "shortest";
+                run_case(options, "RopodRobotPose2DSchema/precision=" + precision + "/encode-" + suffix, result, "encode", bytes, [&](size_t i) {
+                    sink = encode(messages[i % messages_per_case], OptionalMembers::WRITE_NULL, notation).size();
+                });
+                RopodRobotPose2DSchemaEmitter emitter(messages[0], OptionalMembers::WRITE_NULL, notation);
+                run_case(options, "RopodRobotPose2DSchema/precision=" + precision + "/emit-" + suffix, result, "emit", bytes, [&](size_t i) {
+                    const RopodRobotPose2DSchema & x = messages[i % messages_per_case];
+                    const Pose2D & pose = x.get_payload().get_pose();
+                    sink = emitter.emit(x.get_header().get_msg_id(), *x.get_header().get_timestamp(), pose.get_x(), pose.get_y(), pose.get_theta(), x.get_payload().get_timestamp()).size();
+                });
+            }
+            run_case(options, "RopodRobotPose2DSchema/precision=" + precision + "/decode", result, "decode", bytes, [&](size_t i) {
+                sink = static_cast<bool>(try_decode<RopodRobotPose2DSchema>(texts[i % messages_per_case]));
+            });
+        }
+    }
+
+    /**
+     * Rejects malformed RopodElevatorStatusSchema messages - a queryId that is not a UUID, an
+     * unknown query, a floor that is a string and text cut off halfway - with try_decode,
+     * with decode and a catch, and with json::parse and get and a catch.
+     */
+    void run_malformed(const Options & options) {
+        MessageGenerator generator(options.seed);
+        std::vector<json> messages(messages_per_case);
+        for (json & message : messages) {
+            RopodElevatorStatusSchema x;
+            generator.generate(x);
+            message = x;
+        }
+        const std::pair<const char *, void (*)(json &)> mutations[] = {
+            { "bad-uuid", [](json & j) { j["payload"]["queryId"] = "not-a-uuid"; } },
+            { "unknown-enum", [](json & j) { j["payload"]["query"] = "NO_SUCH_QUERY"; } },
+            { "wrong-type", [](json & j) { j["payload"]["floor"] = "69"; } },
+            { "truncated", nullptr }
+        };
+        for (const auto & mutation : mutations) {
+            std::vector<std::string> texts(messages_per_case);
+            double bytes = 0;
+            for (size_t i = 0; i < messages_per_case; i++) {
+                json message = messages[i];
+                if (mutation.second) mutation.second(message);
+                texts[i] = message.dump();
+                if (!mutation.second) texts[i].resize(texts[i].size() / 2);
+                bytes += static_cast<double>(texts[i].size());
+            }
+            bytes /= messages_per_case;
+
+            const std::string name = std::string("RopodElevatorStatusSchema/malformed=") + mutation.first;
+            json result;
+            result["root"] = "RopodElevatorStatusSchema";
+            result["shape"] = {{"malformed", mutation.first}};
+            run_case(options, name + "/try_decode", result, "try_decode", bytes, [&](size_t i) {
+                sink = static_cast<bool>(try_decode<RopodElevatorStatusSchema>(texts[i % messages_per_case]));
+            });
+            run_case(options, name + "/decode-catch", result, "decode-catch", bytes, [&](size_t i) {
+                try {
+                    decode<RopodElevatorStatusSchema>(texts[i % messages_per_case]);
+                    sink = 1;
+                } catch (const std::exception &) {
+                    sink = 0;
+                }
+            });
+            run_case(options, name + "/json-parse-get", result, "json-parse-get", bytes, [&](size_t i) {
+                try {
+                    json::parse(texts[i % messages_per_case]).get<RopodElevatorStatusSchema>();
+                    sink = 1;
+                } catch (...) {
+                    // the enum from_json functions throw a string literal
+                    sink = 0;
+                }
+            });
+        }
+    }
+
+    /**
+     * Decodes a mixed recording of batch messages, three quarters poses, with decode_batch
+     * into Message and into Lazy<Message> (whose payloads are then decoded on the same pool),
+     * on 1, 2, 4, ... threads up to --max-threads, by default one per core.
+     */
+    void run_batches(const Options & options) {
+        const size_t batch = 4096;
+        MessageGenerator generator(options.seed);
+        std::vector<std::string> texts;
+        double bytes = 0;
+        const auto add = [&](auto x) {
+            generator.generate(x);
+            texts.push_back(encode(x));
+            bytes += static_cast<double>(texts.back().size());
+        };
+        // of every 32 messages, 24 are poses and the rest tasks, reports and commands
+        for (size_t i = 0; i < batch; i++) {
+            const size_t slot = i % 32;
+            if (slot < 24) add(RopodRobotPose2DSchema());
+            else if (slot < 25) add(RopodTaskSchema());
+            else if (slot < 27) add(RopodComponentMonitorSchema());
+            else if (slot < 29) add(RopodElevatorStatusSchema());
+            else add(RopodCmdSchema());
+        }
+
+        std::vector<size_t> thread_counts;
+        for (size_t threads = 1; threads < options.max_threads; threads *= 2) thread_counts.push_back(threads);
+        thread_counts.push_back(std::max<size_t>(options.max_threads, 1));
+        for (size_t threads : thread_counts) {
+            WorkerPool pool(threads);
+            const std::string shape = "batch=" + std::to_string(batch) + ",threads=" + std::to_string(threads);
+            json result;
+            result["root"] = "Message";
+            result["shape"] = {{"batch", batch}, {"threads", threads}};
+            std::vector<Message> messages;
+            run_case(options, "Message/" + shape + "/decode_batch", result, "decode_batch", bytes, [&](size_t) {
+                sink = decode_batch(texts, messages, pool).size();
+            });
+            std::vector<Lazy<Message>> lazy_messages;
+            run_case(options, "Message/" + shape + "/decode_batch-lazy", result, "decode_batch-lazy", bytes, [&](size_t) {
+                sink = decode_batch(texts, lazy_messages, pool).size();
+                pool.run(batch, 64, [&](size_t first, size_t last) {
+                    for (size_t i = first; i < last; i++) sink = lazy_messages[i].get().which();
+                });
+            });
+        }
+    }
+
+    /**
+     * Formats date-time time stamps 10 ms apart, as a publisher stamping messages would, with
+     * Instant::format and with an InstantFormatter, in UTC and with an offset.
+     */
+    void run_instants(const Options & options) {
+        for (int offset : {static_cast<int>(Instant::utc), 120}) {
+            std::vector<Instant> instants;
+            double bytes = 0;
+            for (size_t i = 0; i < messages_per_case; i++) {
+                instants.emplace_back((INT64_C(1546300800000) + static_cast<int64_t>(options.seed + 10 * i)) * 1000000, true);
+                instants.back().set_offset(offset);
+                bytes += static_cast<double>(instants.back().to_string().size());
+            }
+            bytes /= messages_per_case;
+
+            const std::string zone = offset == Instant::utc ? "utc" : "offset";
+            json result;
+            result["root"] = "Instant";
+            result["shape"] = {{"offset", offset != Instant::utc}};
+            run_case(options, "Instant/" + zone + "/format", result, "format", bytes, [&](size_t i) {
+                char text[Instant::max_text_length];
+                sink = instants[i % messages_per_case].format(text);
+            });
+            InstantFormatter formatter;
+            run_case(options, "Instant/" + zone + "/InstantFormatter", result, "InstantFormatter", bytes, [&](size_t i) {
+                char text[Instant::max_text_length];
+                sink = formatter.format(instants[i % messages_per_case], text);
+            });
+        }
+    }
+
+    /**
+     * The default shape, then one axis changed at a time: no and many receivers, no optional
+     * members, and for tasks the number of actions with and without debug geometry.
+     */
+    std::vector<MessageShape> shapes(bool header, bool actions) {
+        std::vector<MessageShape> result(1);
+        if (header) {
+            result.emplace_back();
+            result.back().set_receivers(0);
+            result.emplace_back();
+            result.back().set_receivers(32);
+        }
+        result.emplace_back();
+        result.back().set_optionals(false);
+        if (actions) {
+            for (size_t count : {1, 10, 100, 500}) {
+                for (bool debug : {true, false}) {
+                    result.emplace_back();
+                    result.back().set_actions(count);
+                    result.back().set_debug_geometry(debug);
+                }
+            }
+        }
+        return result;
+    }
+}
+
+int main(int argc, char ** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) options.filter = argv[++i];
+        else if (arg == "--min-time" && i + 1 < argc) options.min_time_ms = std::atof(argv[++i]);
+        else if (arg == "--seed" && i + 1 < argc) options.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--max-threads" && i + 1 < argc) options.max_threads = std::strtoull(argv[++i], nullptr, 10);
+        else {
+            std::cerr << "usage: " << argv[0] << " [--filter TEXT] [--min-time MS] [--seed N] [--max-threads N]" << std::endl;
+            return 2;
+        }
+    }
+
+    const std::vector<MessageShape> message_shapes = shapes(true, false);
+    run_root<RopodBlackBoxDataQuerySchema>(options, "RopodBlackBoxDataQuerySchema", message_shapes);
+    run_root<RopodBlackBoxLatestDataQuerySchema>(options, "RopodBlackBoxLatestDataQuerySchema", message_shapes);
+    run_root<RopodBlackBoxLoggingCmdSchema>(options, "RopodBlackBoxLoggingCmdSchema", message_shapes);
+    run_root<RopodBlackBoxVariableQuerySchema>(options, "RopodBlackBoxVariableQuerySchema", message_shapes);
+    run_root<RopodCmdSchema>(options, "RopodCmdSchema", message_shapes);
+    run_root<RopodComponentMonitorSchema>(options, "RopodComponentMonitorSchema", message_shapes);
+    run_root<RopodElevatorCmdSchema>(options, "RopodElevatorCmdSchema", message_shapes);
+    run_root<RopodElevatorStatusSchema>(options, "RopodElevatorStatusSchema", message_shapes);
+    run_root<RopodExperimentCancel>(options, "RopodExperimentCancel", message_shapes);
+    run_root<RopodExperimentRequest>(options, "RopodExperimentRequest", message_shapes);
+    run_root<RopodExperimentSmSchema>(options, "RopodExperimentSmSchema", message_shapes);
+    run_root<RopodFmsElevatorSchema>(options, "RopodFmsElevatorSchema", message_shapes);
+    run_root<RopodMsgSchema>(options, "RopodMsgSchema", message_shapes);
+    run_root<RopodRobotPose2DSchema>(options, "RopodRobotPose2DSchema", message_shapes);
+    run_root<RopodTaskRequestSchema>(options, "RopodTaskRequestSchema", message_shapes);
+    run_root<RopodTaskSchema>(options, "RopodTaskSchema", shapes(true, true));
+    run_root<RopodUnitsSchema>(options, "RopodUnitsSchema", shapes(false, false));
+    run_pose_numbers(options);
+    run_malformed(options);
+    run_batches(options);
+    run_instants(options);
+    return 0;
+}
@@ -6,6 +6,10 @@
 //  Then include this file, and then do
 //
 //     RopodElevatorStatusSchema data = nlohmann::json::parse(jsonString);
+//
+//  or, without building a json DOM first,
+//
+//     RopodElevatorStatusSchema data = quicktype::decode<quicktype::RopodElevatorStatusSchema>(jsonString);
 
 #pragma once
 
@@ -13,8 +17,21 @@
 #include "json.hpp"
 
 #include <boost/optional.hpp>
+#include <boost/utility/string_view.hpp>
 #include <stdexcept>
+#include <cstring>
+#include <cmath>
+#include <clocale>
 #include <regex>
+#include <bitset>
+#include <mutex>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
 
 #ifndef NLOHMANN_OPT_HELPER
 #define NLOHMANN_OPT_HELPER
@@ -26,477 +43,4915 @@ namespace nlohmann {
         }
 
         static std::shared_ptr<T> from_json(const json & j) {
-            if (j.is_null()) return std::unique_ptr<T>(); else return std::unique_ptr<T>(new T(j.get<T>()));
+            if (j.is_null()) return std::shared_ptr<T>();
+            std::shared_ptr<T> opt = std::make_shared<T>();
+            adl_serializer<T>::from_json(j, *opt);
+            return opt;
+        }
+    };
+
+    template <typename T>
+    struct adl_serializer<boost::optional<T>> {
+        static void to_json(json & j, const boost::optional<T> & opt) {
+            if (!opt) j = nullptr; else j = *opt;
+        }
+
+        static boost::optional<T> from_json(const json & j) {
+            if (j.is_null()) return boost::optional<T>();
+            // read into a value-initialised T, which GCC can see is initialised, then move it in
+            T value = T();
+            adl_serializer<T>::from_json(j, value);
+            return boost::optional<T>(std::move(value));
         }
     };
 }
 #endif
 
+#ifndef QUICKTYPE_OPTIONAL_HELPER
+#define QUICKTYPE_OPTIONAL_HELPER
 namespace quicktype {
     using nlohmann::json;
 
-    class ClassMemberConstraints {
-        private:
-        boost::optional<int> min_value;
-        boost::optional<int> max_value;
-        boost::optional<size_t> min_length;
-        boost::optional<size_t> max_length;
-        boost::optional<std::string> pattern;
+    /**
+     * Storage of optional members. By default optional members are heap allocated and
+     * shared through std::shared_ptr. Define QUICKTYPE_INLINE_OPTIONALS before including the
+     * schema headers to store them inline with a presence flag instead; getters return a
+     * const reference in both modes.
+     */
+#ifdef QUICKTYPE_INLINE_OPTIONALS
+    template <typename T>
+    using optional = boost::optional<T>;
+#else
+    template <typename T>
+    using optional = std::shared_ptr<T>;
+#endif
 
-        public:
-        ClassMemberConstraints(
-            boost::optional<int> min_value,
-            boost::optional<int> max_value,
-            boost::optional<size_t> min_length,
-            boost::optional<size_t> max_length,
-            boost::optional<std::string> pattern
-        ) : min_value(min_value), max_value(max_value), min_length(min_length), max_length(max_length), pattern(pattern) {}
-        ClassMemberConstraints() = default;
-        virtual ~ClassMemberConstraints() = default;
+    template <typename T>
+    inline optional<T> get_optional(const json & j, const char * property) {
+        if (j.find(property) != j.end()) {
+            return j.at(property).get<optional<T>>();
+        }
+        return optional<T>();
+    }
 
-        void set_min_value(int min_value) { this->min_value = min_value; }
-        auto get_min_value() const { return min_value; }
+    template <typename T>
+    inline optional<T> get_optional(const json & j, std::string property) {
+        return get_optional<T>(j, property.data());
+    }
+}
+#endif
 
-        void set_max_value(int max_value) { this->max_value = max_value; }
-        auto get_max_value() const { return max_value; }
+#ifndef QUICKTYPE_KEY_HELPER
+#define QUICKTYPE_KEY_HELPER
+namespace quicktype {
+    /**
+     * FNV-1a hash of an object key. The generated decoders switch on it to dispatch each
+     * member to its field in a single pass over the object. Enum decoders pass a seed found
+     * by the generator that maps the enum's names to distinct slots (a perfect hash).
+     */
+    constexpr uint32_t hash_key(const char * data, size_t size, uint32_t seed = 2166136261u) {
+        uint32_t hash = seed;
+        for (size_t i = 0; i < size; i++) hash = (hash ^ static_cast<unsigned char>(data[i])) * 16777619u;
+        return hash;
+    }
 
-        void set_min_length(size_t min_length) { this->min_length = min_length; }
-        auto get_min_length() const { return min_length; }
+    template <size_t N>
+    constexpr uint32_t hash_key(const char (&key)[N]) {
+        return hash_key(key, N - 1);
+    }
+}
+#endif
 
-        void set_max_length(size_t max_length) { this->max_length = max_length; }
-        auto get_max_length() const { return max_length; }
+#ifndef QUICKTYPE_READER_HELPER
+#define QUICKTYPE_READER_HELPER
+namespace quicktype {
+    using nlohmann::json;
 
-        void set_pattern(const std::string &  pattern) { this->pattern = pattern; }
-        auto get_pattern() const { return pattern; }
-    };
+    enum class JsonToken : int { ARRAY, BOOLEAN, END, INVALID, NULL_VALUE, NUMBER, OBJECT, STRING };
 
-    class ClassMemberConstraintException : public std::runtime_error {
-        public:
-        ClassMemberConstraintException(const std::string &  msg) : std::runtime_error(msg) {}
-    };
+    enum class DecodeErrorKind : int { CONSTRAINT_VIOLATION, INVALID_ENUM_VALUE, MISSING_KEY, OUT_OF_RANGE, SYNTAX_ERROR, TYPE_MISMATCH };
 
-    class ValueTooLowException : public ClassMemberConstraintException {
+    class JsonDecodeException : public std::runtime_error {
         public:
-        ValueTooLowException(const std::string &  msg) : ClassMemberConstraintException(msg) {}
+        JsonDecodeException(const std::string &  msg) : std::runtime_error(msg) {}
     };
 
-    class ValueTooHighException : public ClassMemberConstraintException {
-        public:
-        ValueTooHighException(const std::string &  msg) : ClassMemberConstraintException(msg) {}
-    };
+    /**
+     * Why and where decoding failed. The path is a JSON pointer (RFC 6901) to the offending
+     * value, or to the missing member; the offset is the byte position at which the error was
+     * detected.
+     */
+    class DecodeError {
+        private:
+        DecodeErrorKind kind;
+        std::string message;
+        std::string path;
+        size_t offset;
 
-    class ValueTooShortException : public ClassMemberConstraintException {
         public:
-        ValueTooShortException(const std::string &  msg) : ClassMemberConstraintException(msg) {}
-    };
+        DecodeError(DecodeErrorKind kind, std::string message, std::string path, size_t offset)
+            : kind(kind), message(std::move(message)), path(std::move(path)), offset(offset) {}
 
-    class ValueTooLongException : public ClassMemberConstraintException {
-        public:
-        ValueTooLongException(const std::string &  msg) : ClassMemberConstraintException(msg) {}
-    };
+        DecodeErrorKind get_kind() const { return kind; }
+        const std::string & get_message() const { return message; }
+        const std::string & get_path() const { return path; }
+        size_t get_offset() const { return offset; }
 
-    class InvalidPatternException : public ClassMemberConstraintException {
-        public:
-        InvalidPatternException(const std::string &  msg) : ClassMemberConstraintException(msg) {}
+        std::string to_string() const {
+            if (path.empty()) return message + " at byte " + std::to_string(offset);
+            return message + " at " + path + " (byte " + std::to_string(offset) + ")";
+        }
     };
 
-    void CheckConstraint(const std::string &  name, const ClassMemberConstraints & c, int64_t value) {
-        if (c.get_min_value() != boost::none && value < *c.get_min_value()) {
-            throw ValueTooLowException ("Value too low for " + name + " (" + std::to_string(value) + "<" + std::to_string(*c.get_min_value()) + ")");
+    /**
+     * Length of the well-formed UTF-8 sequence at p (RFC 3629), or 0 if it is malformed.
+     */
+    inline size_t utf8_sequence_length(const unsigned char * p, const unsigned char * last) {
+        const unsigned char c = p[0];
+        size_t length;
+        unsigned char lo = 0x80, hi = 0xBF;
+        if (c >= 0xC2 && c <= 0xDF) length = 2;
+        else if (c >= 0xE0 && c <= 0xEF) {
+            length = 3;
+            if (c == 0xE0) lo = 0xA0;
+            if (c == 0xED) hi = 0x9F;
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            length = 4;
+            if (c == 0xF0) lo = 0x90;
+            if (c == 0xF4) hi = 0x8F;
+        } else return 0;
+        if (static_cast<size_t>(last - p) < length) return 0;
+        if (p[1] < lo || p[1] > hi) return 0;
+        for (size_t i = 2; i < length; i++) {
+            if (p[i] < 0x80 || p[i] > 0xBF) return 0;
         }
+        return length;
+    }
 
-        if (c.get_max_value() != boost::none && value > *c.get_max_value()) {
-            throw ValueTooHighException ("Value too high for " + name + " (" + std::to_string(value) + ">" + std::to_string(*c.get_max_value()) + ")");
+    /**
+     * Pull reader over JSON text. The generated read_json functions use it to fill the typed
+     * classes straight from the token stream, without building a json DOM first.
+     *
+     * Reading never throws: the first error is recorded, the reader skips to the end of the
+     * input and every later call is a no-op, so callers only need to check ok() once. Decoders
+     * returning from a failed member add its key or index to the error's path, so the path
+     * costs nothing unless decoding fails.
+     */
+    class JsonReader {
+        private:
+        const char * begin;
+        const char * cur;
+        const char * end;
+        bool after_open = false;
+        size_t depth = 0;
+        std::string buffer;
+        bool failed = false;
+        DecodeErrorKind error_kind = DecodeErrorKind::SYNTAX_ERROR;
+        std::string error_message;
+        std::string error_path;
+        size_t error_offset = 0;
+
+        static const size_t max_depth = 1024;
+
+        void skip_whitespace() {
+            while (cur < end && (*cur == ' ' || *cur == '\n' || *cur == '\r' || *cur == '\t')) cur++;
         }
-    }
 
-    void CheckConstraint(const std::string &  name, const ClassMemberConstraints & c, const std::string &  value) {
-        if (c.get_min_length() != boost::none && value.length() < *c.get_min_length()) {
-            throw ValueTooShortException ("Value too short for " + name + " (" + std::to_string(value.length()) + "<" + std::to_string(*c.get_min_length()) + ")");
+        bool consume(char c) {
+            skip_whitespace();
+            if (cur < end && *cur == c) {
+                cur++;
+                return true;
+            }
+            return false;
         }
 
-        if (c.get_max_length() != boost::none && value.length() > *c.get_max_length()) {
-            throw ValueTooLongException ("Value too long for " + name + " (" + std::to_string(value.length()) + ">" + std::to_string(*c.get_max_length()) + ")");
+        bool consume_literal(const char * literal, size_t length) {
+            skip_whitespace();
+            if (static_cast<size_t>(end - cur) < length || std::memcmp(cur, literal, length) != 0) return false;
+            cur += length;
+            return true;
         }
 
-        if (c.get_pattern() != boost::none) {
-            std::smatch result;
-            std::regex_search(value, result, std::regex( *c.get_pattern() ));
-            if (result.empty()) {
-                throw InvalidPatternException ("Value doesn't match pattern for " + name + " (" + value +" != " + *c.get_pattern() + ")");
-            }
+        void fail_type(const char * expected) {
+            const JsonToken token = peek();
+            const DecodeErrorKind kind = token == JsonToken::END || token == JsonToken::INVALID ? DecodeErrorKind::SYNTAX_ERROR : DecodeErrorKind::TYPE_MISMATCH;
+            fail(kind, std::string("type must be ") + expected + ", but is " + token_name(token));
         }
-    }
 
-    inline json get_untyped(const json & j, const char * property) {
-        if (j.find(property) != j.end()) {
-            return j.at(property).get<json>();
+        static const char * token_name(JsonToken token) {
+            switch (token) {
+                case JsonToken::ARRAY: return "array";
+                case JsonToken::BOOLEAN: return "boolean";
+                case JsonToken::END: return "end of input";
+                case JsonToken::NULL_VALUE: return "null";
+                case JsonToken::NUMBER: return "number";
+                case JsonToken::OBJECT: return "object";
+                case JsonToken::STRING: return "string";
+                default: return "invalid literal";
+            }
         }
-        return json();
-    }
 
-    inline json get_untyped(const json & j, std::string property) {
-        return get_untyped(j, property.data());
-    }
+        static int hex_value(char c) {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
 
-    template <typename T>
-    inline std::shared_ptr<T> get_optional(const json & j, const char * property) {
-        if (j.find(property) != j.end()) {
-            return j.at(property).get<std::shared_ptr<T>>();
+        bool read_hex4(unsigned int & code) {
+            if (end - cur < 4) return false;
+            code = 0;
+            for (int i = 0; i < 4; i++) {
+                const int h = hex_value(cur[i]);
+                if (h < 0) return false;
+                code = (code << 4) | static_cast<unsigned int>(h);
+            }
+            cur += 4;
+            return true;
         }
-        return std::shared_ptr<T>();
-    }
 
-    template <typename T>
-    inline std::shared_ptr<T> get_optional(const json & j, std::string property) {
-        return get_optional<T>(j, property.data());
-    }
+        static void append_utf8(std::string & out, unsigned int code) {
+            if (code < 0x80) {
+                out += static_cast<char>(code);
+            } else if (code < 0x800) {
+                out += static_cast<char>(0xC0 | (code >> 6));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            } else if (code < 0x10000) {
+                out += static_cast<char>(0xE0 | (code >> 12));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            } else {
+                out += static_cast<char>(0xF0 | (code >> 18));
+                out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+        }
 
-    /**
-     * Metamodel identifier for a generic  messages. It actually points to this Schema.
-     */
-    enum class MsgMetamodel : int { ROPOD_MSG_SCHEMA_JSON };
+        /**
+         * Reads a string token. Strings without escapes are returned as a view into the input;
+         * strings with escapes are unescaped into the reader's buffer, which stays valid until
+         * the next string is read.
+         */
+        bool read_string_token(boost::string_view & value) {
+            if (!consume('"')) {
+                fail_type("string");
+                return false;
+            }
+            const char * start = cur;
+            bool escaped = false;
+            while (true) {
+                while (cur < end && static_cast<unsigned char>(*cur) >= 0x20 && *cur != '"' && *cur != '\\' && static_cast<unsigned char>(*cur) < 0x80) cur++;
+                if (cur >= end) {
+                    fail(DecodeErrorKind::SYNTAX_ERROR, "syntax error while parsing string: missing closing quote");
+                    return false;
+                }
+                const unsigned char c = static_cast<unsigned char>(*cur);
+                if (c == '"') break;
+                if (c < 0x20) {
+                    fail(DecodeErrorKind::SYNTAX_ERROR, "syntax error while parsing string: control character must be escaped");
+                    return false;
+                }
+                if (c >= 0x80) {
+                    const size_t length = utf8_sequence_length(reinterpret_cast<const unsigned char *>(cur), reinterpret_cast<const unsigned char *>(end));
+                    if (length == 0) {
+                        fail(DecodeErrorKind::SYNTAX_ERROR, "syntax error while parsing string: invalid UTF-8 byte");
+                        return false;
+                    }
+                    if (escaped) buffer.append(cur, length);
+                    cur += length;
+                    continue;
+                }
+                if (!escaped) {
+                    buffer.assign(start, cur);
+                    escaped = true;
+                }
+                cur++;
+                if (cur >= end) {
+                    fail(DecodeErrorKind::SYNTAX_ERROR, "syntax error while parsing string: missing closing quote");
+                    return false;
+                }
+                const char e = *cur++;
+                switch (e) {
+                    case '"': buffer += '"'; break;
+                    case '\\': buffer += '\\'; break;
+                    case '/': buffer += '/'; break;
+                    case 'b': buffer += '\b'; break;
+                    case 'f': buffer += '\f'; break;
+                    case 'n': buffer += '\n'; break;
+                    case 'r': buffer += '\r'; break;
+                    case 't': buffer += '\t'; break;
+                    case 'u': {
+                        unsigned int code;
+                        if (!read_hex4(code)) {
+                            fail(DecodeErrorKind::SYNTAX_ERROR, "syntax error while parsing string: '\\u' must be followed by 4 hex digits");
+                            return false;
+                        }
+                        if (code >= 0xD800 && code <= 0xDBFF) {
+                            unsigned int low;
+                            if (end - cur < 2 || cur[0] != '\\' || cur[1] != 'u' || (cur += 2, !read_hex4(low)) || low < 0xDC00 || low > 0xDFFF) {
+                                fail(DecodeErrorKind::SYNTAX_ERROR, "syntax error while parsing string: surrogate U+D800..U+DBFF must be followed by U+DC00..U+DFFF");
+                                return false;
+                            }
+                            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        } else if (code >= 0xDC00 && code <= 0xDFFF) {
+                            fail(DecodeErrorKind::SYNTAX_ERROR, "syntax error while parsing string: surrogate U+DC00..U+DFFF must follow U+D800..U+DBFF");
+                            return false;
+                        }
+                        append_utf8(buffer, code);
+                        break;
+                    }
+                    default:
+                        fail(DecodeErrorKind::SYNTAX_ERROR, "syntax error while parsing string: invalid escape");
+                        return false;
+                }
+                start = cur;
+                while (cur < end && static_cast<unsigned char>(*cur) >= 0x20 && *cur != '"' && *cur != '\\' && static_cast<unsigned char>(*cur) < 0x80) cur++;
+                buffer.append(start, cur);
+            }
+            value = escaped ? boost::string_view(buffer) : boost::string_view(start, static_cast<size_t>(cur - start));
+            cur++;
+            return true;
+        }
 
-    using TimeStamp = std::shared_ptr<boost::variant<double, std::string>>;
+        /**
+         * Scans a number token following the JSON grammar.
+         */
+        bool read_number_token(const char *& first, const char *& last, bool & is_integer) {
+            skip_whitespace();
+            first = cur;
+            const char * p = cur;
+            is_integer = true;
+            if (p < end && *p == '-') p++;
+            if (p < end && *p == '0') p++;
+            else if (p < end && *p >= '1' && *p <= '9') while (p < end && *p >= '0' && *p <= '9') p++;
+            else {
+                fail_type("number");
+                return false;
+            }
+            if (p < end && *p == '.') {
+                is_integer = false;
+                p++;
+                if (p >= end || *p < '0' || *p > '9') {
+                    fail(DecodeErrorKind::SYNTAX_ERROR, "syntax error while parsing number: expected digit after '.'");
+                    return false;
+                }
+                while (p < end && *p >= '0' && *p <= '9') p++;
+            }
+            if (p < end && (*p == 'e' || *p == 'E')) {
+                is_integer = false;
+                p++;
+                if (p < end && (*p == '+' || *p == '-')) p++;
+                if (p >= end || *p < '0' || *p > '9') {
+                    fail(DecodeErrorKind::SYNTAX_ERROR, "syntax error while parsing number: expected digit in exponent");
+                    return false;
+                }
+                while (p < end && *p >= '0' && *p <= '9') p++;
+            }
+            last = p;
+            cur = p;
+            return true;
+        }
 
-    /**
-     * Id of receiver. Can be UUID or any string. This is optional.
-     *
-     * A time stamp using the date-time format. An RFC3339  Section 5.6 timestamp in UTC time.
-     * This is formatted as YYYY-MM-DDThh:mm:ss.fffZ. The milliseconds portion .fff is
-     * optional.
-     *
-     * Type identifier for the payload. This is usually an enum like type. E.g. CMD. More
-     * specific Schemata will further specify what will be required here.
-     *
-     * Version of message type. E.g. 0.1.0
-     *
-     * Metamodel identifier for the payload. This is usually a Schmea file like
-     * ropod-cmd-schema.json. More specific Schemata will further specify what will be required
-     * here.
-     */
-    enum class TypeEnum : int { ELEVATOR_STATUS, ELEVATOR_STATUS_QUERY };
+#ifdef __SIZEOF_INT128__
+        /**
+         * Rounds (value + sticky fraction) * 2^exponent to the nearest double, ties to even.
+         * sticky says whether nonzero bits below value were dropped. value must be nonzero and
+         * the result a normal double.
+         */
+        static double round_to_double(unsigned __int128 value, int exponent, bool sticky) {
+            const uint64_t high = static_cast<uint64_t>(value >> 64);
+            const int top = high != 0 ? 127 - __builtin_clzll(high) : 63 - __builtin_clzll(static_cast<uint64_t>(value));
+            if (top <= 52) return std::ldexp(static_cast<double>(static_cast<uint64_t>(value)), exponent);
+            const int shift = top - 52;
+            uint64_t mantissa = static_cast<uint64_t>(value >> shift);
+            const unsigned __int128 rest = value & ((static_cast<unsigned __int128>(1) << shift) - 1);
+            const unsigned __int128 half = static_cast<unsigned __int128>(1) << (shift - 1);
+            if (rest > half || (rest == half && (sticky || (mantissa & 1) != 0))) mantissa++;
+            return std::ldexp(static_cast<double>(mantissa), exponent + shift);
+        }
+#endif
 
-    /**
-     * Complete specification of required and optioanl header parts.
-     *
-     * More spefific definition (than the definition of ropod-msg-schema.json). Only the type
-     * field is further specified.
-     */
-    class Header {
-        public:
-        Header() :
-            msg_id_constraint(boost::none, boost::none, boost::none, boost::none, std::string("^[a-fA-F0-9]{8}-[a-fA-F0-9]{4}-[a-fA-F0-9]{4}-[a-fA-F0-9]{4}-[a-fA-F0-9]{12}$"))
-        {}
-        virtual ~Header() = default;
+        /**
+         * Converts a number token exactly without strtod, for tokens of at most 19 significant
+         * digits and a decimal exponent within [-22, 22] (27 with 128-bit integers): Clinger's
+         * fast path when the digits fit a double's mantissa, otherwise an exact 128-bit
+         * product or quotient by a power of five. Returns false for other tokens.
+         */
+        static bool fast_to_double(const char * p, const char * last, double & value) {
+            static const double powers[] = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+            const bool negative = *p == '-';
+            if (negative) p++;
+            uint64_t mantissa = 0;
+            int digits = 0;
+            int exponent = 0;
+            for (; p < last && *p >= '0' && *p <= '9'; p++) {
+                if (digits == 19) return false;
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                if (mantissa != 0) digits++;
+            }
+            if (p < last && *p == '.') {
+                for (p++; p < last && *p >= '0' && *p <= '9'; p++) {
+                    if (digits == 19) return false;
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                    if (mantissa != 0) digits++;
+                    exponent--;
+                }
+            }
+            if (p < last && (*p == 'e' || *p == 'E')) {
+                p++;
+                const bool negative_exponent = *p == '-';
+                if (*p == '-' || *p == '+') p++;
+                int written = 0;
+                for (; p < last; p++) {
+                    if (written < 10000) written = written * 10 + (*p - '0');
+                }
+                exponent += negative_exponent ? -written : written;
+            }
+            if (mantissa == 0) {
+                value = negative ? -0.0 : 0.0;
+                return true;
+            }
+            if (mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+                const double m = static_cast<double>(mantissa);
+                value = exponent < 0 ? m / powers[-exponent] : m * powers[exponent];
+            } else {
+#ifdef __SIZEOF_INT128__
+                static const uint64_t powers_of_five[] = {
+                    1ull, 5ull, 25ull, 125ull, 625ull, 3125ull, 15625ull, 78125ull, 390625ull,
+                    1953125ull, 9765625ull, 48828125ull, 244140625ull, 1220703125ull, 6103515625ull,
+                    30517578125ull, 152587890625ull, 762939453125ull, 3814697265625ull,
+                    19073486328125ull, 95367431640625ull, 476837158203125ull, 2384185791015625ull,
+                    11920928955078125ull, 59604644775390625ull, 298023223876953125ull,
+                    1490116119384765625ull, 7450580596923828125ull
+                };
+                if (exponent >= 0 && exponent <= 27) {
+                    // mantissa * 10^e = (mantissa * 5^e) * 2^e, the product exact in 128 bits
+                    value = round_to_double(static_cast<unsigned __int128>(mantissa) * powers_of_five[exponent], exponent, false);
+                } else if (exponent < 0 && exponent >= -22) {
+                    // mantissa * 10^e = (mantissa * 2^s / 5^-e) * 2^(e - s), with s shifting
+                    // mantissa to the top of 128 bits so the quotient keeps 75+ bits
+                    const int shift = 64 + __builtin_clzll(mantissa);
+                    const unsigned __int128 numerator = static_cast<unsigned __int128>(mantissa) << shift;
+                    const uint64_t divisor = powers_of_five[-exponent];
+                    value = round_to_double(numerator / divisor, exponent - shift, numerator % divisor != 0);
+                } else {
+                    return false;
+                }
+#else
+                return false;
+#endif
+            }
+            if (negative) value = -value;
+            return true;
+        }
 
-        private:
-        MsgMetamodel metamodel;
-        std::string msg_id;
-        ClassMemberConstraints msg_id_constraint;
-        std::shared_ptr<std::vector<std::string>> receiver_ids;
-        TimeStamp timestamp;
-        TypeEnum type;
-        std::shared_ptr<std::string> version;
+        static double to_double(const char * first, const char * last) {
+            double value;
+            if (fast_to_double(first, last, value)) return value;
+            char local[64];
+            std::string heap;
+            char * text = local;
+            const size_t length = static_cast<size_t>(last - first);
+            if (length >= sizeof(local)) {
+                heap.assign(first, last);
+                text = &heap[0];
+            } else {
+                std::memcpy(local, first, length);
+                local[length] = '\0';
+            }
+            const char decimal_point = *std::localeconv()->decimal_point;
+            if (decimal_point != '.') {
+                for (char * p = text; *p; p++) if (*p == '.') *p = decimal_point;
+            }
+            return std::strtod(text, nullptr);
+        }
 
         public:
-        const MsgMetamodel & get_metamodel() const { return metamodel; }
-        MsgMetamodel & get_mutable_metamodel() { return metamodel; }
-        void set_metamodel(const MsgMetamodel & value) { this->metamodel = value; }
-
-        const std::string & get_msg_id() const { return msg_id; }
-        std::string & get_mutable_msg_id() { return msg_id; }
-        void set_msg_id(const std::string & value) { CheckConstraint("msg_id", msg_id_constraint, value); this->msg_id = value; }
+        JsonReader(const char * data, size_t size) : begin(data), cur(data), end(data + size) {
+            if (size >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0) cur += 3;
+        }
+        explicit JsonReader(const std::string & text) : JsonReader(text.data(), text.size()) {}
 
-        std::shared_ptr<std::vector<std::string>> get_receiver_ids() const { return receiver_ids; }
-        void set_receiver_ids(std::shared_ptr<std::vector<std::string>> value) { this->receiver_ids = value; }
+        bool ok() const { return !failed; }
+        size_t position() const { return static_cast<size_t>(cur - begin); }
+        const char * data() const { return begin; }
 
-        TimeStamp get_timestamp() const { return timestamp; }
-        void set_timestamp(TimeStamp value) { this->timestamp = value; }
+        void fail(DecodeErrorKind kind, const std::string & message) {
+            if (ok()) {
+                failed = true;
+                error_kind = kind;
+                error_message = message;
+                error_offset = position();
+            }
+            cur = end;
+        }
 
-        const TypeEnum & get_type() const { return type; }
-        TypeEnum & get_mutable_type() { return type; }
-        void set_type(const TypeEnum & value) { this->type = value; }
+        void fail_missing_key(boost::string_view key) {
+            if (!ok()) return;
+            fail(DecodeErrorKind::MISSING_KEY, "key '" + key.to_string() + "' not found");
+            add_error_key(key);
+        }
 
-        std::shared_ptr<std::string> get_version() const { return version; }
-        void set_version(std::shared_ptr<std::string> value) { this->version = value; }
-    };
+        /**
+         * Prepends an object key to the path of the recorded error.
+         */
+        void add_error_key(boost::string_view key) {
+            std::string component = "/";
+            for (const char c : key) {
+                if (c == '~') component += "~0";
+                else if (c == '/') component += "~1";
+                else component += c;
+            }
+            error_path.insert(0, component);
+        }
 
-    /**
-     * Id of receiver. Can be UUID or any string. This is optional.
-     *
-     * A time stamp using the date-time format. An RFC3339  Section 5.6 timestamp in UTC time.
-     * This is formatted as YYYY-MM-DDThh:mm:ss.fffZ. The milliseconds portion .fff is
-     * optional.
-     *
-     * Type identifier for the payload. This is usually an enum like type. E.g. CMD. More
-     * specific Schemata will further specify what will be required here.
-     *
-     * Version of message type. E.g. 0.1.0
-     *
-     * Metamodel identifier for the payload. This is usually a Schmea file like
-     * ropod-cmd-schema.json. More specific Schemata will further specify what will be required
-     * here.
-     *
-     * Metamodel elevator status message.
-     */
-    enum class MetamodelEnum : int { ROPOD_ELEVATOR_STATUS_SCHEMA_JSON };
+        /**
+         * Prepends an array index to the path of the recorded error.
+         */
+        void add_error_index(size_t index) {
+            error_path.insert(0, "/" + std::to_string(index));
+        }
 
-    enum class Query : int { GET_ALL_ELEVATOR_IDS, GET_ELEVATOR_STATUS };
+        DecodeError get_error() const { return DecodeError(error_kind, error_message, error_path, error_offset); }
 
-    /**
-     * Status update for a single elevator.  This is a literal translation of the CAN bus
-     * protocol.
-     */
-    class ElevatorStatusPayload {
-        public:
-        ElevatorStatusPayload() :
-            query_id_constraint(boost::none, boost::none, boost::none, boost::none, std::string("^[a-fA-F0-9]{8}-[a-fA-F0-9]{4}-[a-fA-F0-9]{4}-[a-fA-F0-9]{4}-[a-fA-F0-9]{12}$"))
-        {}
-        virtual ~ElevatorStatusPayload() = default;
+        /**
+         * The recorded error as text, or an empty string if nothing failed.
+         */
+        std::string error() const { return failed ? get_error().to_string() : std::string(); }
 
-        private:
-        MetamodelEnum metamodel;
-        std::shared_ptr<bool> admitted_request_from_robot;
-        std::shared_ptr<int64_t> calls;
-        std::shared_ptr<bool> door_open_at_goal_floor;
-        std::shared_ptr<bool> door_open_at_start_floor;
-        std::shared_ptr<bool> door_waits_for_closing_command;
-        std::shared_ptr<std::vector<int64_t>> elevator_ids;
-        std::shared_ptr<int64_t> floor;
-        std::shared_ptr<int64_t> id;
-        std::shared_ptr<bool> is_available;
-        std::shared_ptr<std::string> query_id;
-        ClassMemberConstraints query_id_constraint;
-        std::shared_ptr<bool> query_success;
-        std::shared_ptr<bool> status_has_changed;
-        std::shared_ptr<Query> query;
+        JsonToken peek() {
+            skip_whitespace();
+            if (cur >= end) return JsonToken::END;
+            switch (*cur) {
+                case '{': return JsonToken::OBJECT;
+                case '[': return JsonToken::ARRAY;
+                case '"': return JsonToken::STRING;
+                case 't': case 'f': return JsonToken::BOOLEAN;
+                case 'n': return JsonToken::NULL_VALUE;
+                case '-': case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9': return JsonToken::NUMBER;
+                default: return JsonToken::INVALID;
+            }
+        }
 
-        public:
-        const MetamodelEnum & get_metamodel() const { return metamodel; }
-        MetamodelEnum & get_mutable_metamodel() { return metamodel; }
-        void set_metamodel(const MetamodelEnum & value) { this->metamodel = value; }
+        bool begin_object() {
+            if (!ok()) return false;
+            if (!consume('{')) {
+                fail_type("object");
+                return false;
+            }
+            if (++depth > max_depth) {
+                fail(DecodeErrorKind::SYNTAX_ERROR, "exceeded maximum nesting depth");
+                return false;
+            }
+            after_open = true;
+            return true;
+        }
 
-        std::shared_ptr<bool> get_admitted_request_from_robot() const { return admitted_request_from_robot; }
-        void set_admitted_request_from_robot(std::shared_ptr<bool> value) { this->admitted_request_from_robot = value; }
+        /**
+         * Advances to the next member of the current object and reads its key. Returns false
+         * once the closing brace has been consumed or an error occurred.
+         */
+        bool next_member(boost::string_view & key) {
+            if (!ok()) return false;
+            if (consume('}')) {
+                depth--;
+                after_open = false;
+                return false;
+            }
+            if (!after_open && !consume(',')) {
+                fail(DecodeErrorKind::SYNTAX_ERROR, "syntax error while parsing object: expected ',' or '}'");
+                return false;
+            }
+            after_open = false;
+            if (peek() != JsonToken::STRING) {
+                fail(DecodeErrorKind::SYNTAX_ERROR, "syntax error while parsing object key: expected string");
+                return false;
+            }
+            if (!read_string_token(key)) return false;
+            if (!consume(':')) {
+                fail(DecodeErrorKind::SYNTAX_ERROR, "syntax error while parsing object separator: expected ':'");
+                return false;
+            }
+            return true;
+        }
 
-        std::shared_ptr<int64_t> get_calls() const { return calls; }
-        void set_calls(std::shared_ptr<int64_t> value) { this->calls = value; }
+        bool begin_array() {
+            if (!ok()) return false;
+            if (!consume('[')) {
+                fail_type("array");
+                return false;
+            }
+            if (++depth > max_depth) {
+                fail(DecodeErrorKind::SYNTAX_ERROR, "exceeded maximum nesting depth");
+                return false;
+            }
+            after_open = true;
+            return true;
+        }
 
-        std::shared_ptr<bool> get_door_open_at_goal_floor() const { return door_open_at_goal_floor; }
-        void set_door_open_at_goal_floor(std::shared_ptr<bool> value) { this->door_open_at_goal_floor = value; }
+        /**
+         * Advances to the next element of the current array. Returns false once the closing
+         * bracket has been consumed or an error occurred.
+         */
+        bool next_element() {
+            if (!ok()) return false;
+            if (consume(']')) {
+                depth--;
+                after_open = false;
+                return false;
+            }
+            if (!after_open && !consume(',')) {
+                fail(DecodeErrorKind::SYNTAX_ERROR, "syntax error while parsing array: expected ',' or ']'");
+                return false;
+            }
+            after_open = false;
+            return true;
+        }
 
-        std::shared_ptr<bool> get_door_open_at_start_floor() const { return door_open_at_start_floor; }
-        void set_door_open_at_start_floor(std::shared_ptr<bool> value) { this->door_open_at_start_floor = value; }
+        /**
+         * Consumes a null and returns true if the next value is null.
+         */
+        bool read_null() {
+            if (peek() != JsonToken::NULL_VALUE) return false;
+            if (!consume_literal("null", 4)) {
+                fail(DecodeErrorKind::SYNTAX_ERROR, "syntax error: invalid literal");
+                return false;
+            }
+            return true;
+        }
 
-        std::shared_ptr<bool> get_door_waits_for_closing_command() const { return door_waits_for_closing_command; }
-        void set_door_waits_for_closing_command(std::shared_ptr<bool> value) { this->door_waits_for_closing_command = value; }
+        void read(boost::string_view & value) {
+            if (ok()) read_string_token(value);
+        }
 
-        std::shared_ptr<std::vector<int64_t>> get_elevator_ids() const { return elevator_ids; }
-        void set_elevator_ids(std::shared_ptr<std::vector<int64_t>> value) { this->elevator_ids = value; }
+        void read(std::string & value) {
+            boost::string_view view;
+            if (ok() && read_string_token(view)) value.assign(view.data(), view.size());
+        }
 
-        std::shared_ptr<int64_t> get_floor() const { return floor; }
-        void set_floor(std::shared_ptr<int64_t> value) { this->floor = value; }
+        void read(bool & value) {
+            if (!ok()) return;
+            if (consume_literal("true", 4)) value = true;
+            else if (consume_literal("false", 5)) value = false;
+            else fail_type("boolean");
+        }
 
-        std::shared_ptr<int64_t> get_id() const { return id; }
-        void set_id(std::shared_ptr<int64_t> value) { this->id = value; }
+        void read(int64_t & value) {
+            const char * first;
+            const char * last;
+            bool is_integer;
+            if (!ok() || !read_number_token(first, last, is_integer)) return;
+            if (!is_integer) {
+                // the cast is only defined for doubles in [-2^63, 2^63)
+                const double d = to_double(first, last);
+                if (!(d >= -9223372036854775808.0 && d < 9223372036854775808.0)) {
+                    fail(DecodeErrorKind::OUT_OF_RANGE, "number overflow");
+                    return;
+                }
+                value = static_cast<int64_t>(d);
+                return;
+            }
+            const bool negative = *first == '-';
+            uint64_t magnitude = 0;
+            for (const char * p = negative ? first + 1 : first; p < last; p++) {
+                const uint64_t digit = static_cast<uint64_t>(*p - '0');
+                if (magnitude > (UINT64_MAX - digit) / 10) {
+                    fail(DecodeErrorKind::OUT_OF_RANGE, "number overflow");
+                    return;
+                }
+                magnitude = magnitude * 10 + digit;
+            }
+            if (magnitude > static_cast<uint64_t>(INT64_MAX) + (negative ? 1 : 0)) {
+                fail(DecodeErrorKind::OUT_OF_RANGE, "number overflow");
+                return;
+            }
+            value = negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+        }
 
-        std::shared_ptr<bool> get_is_available() const { return is_available; }
-        void set_is_available(std::shared_ptr<bool> value) { this->is_available = value; }
+        void read(double & value) {
+            const char * first;
+            const char * last;
+            bool is_integer;
+            if (!ok() || !read_number_token(first, last, is_integer)) return;
+            value = to_double(first, last);
+            if (!std::isfinite(value)) fail(DecodeErrorKind::OUT_OF_RANGE, "number overflow");
+        }
 
-        std::shared_ptr<std::string> get_query_id() const { return query_id; }
-        void set_query_id(std::shared_ptr<std::string> value) { if (value) CheckConstraint("query_id", query_id_constraint, *value); this->query_id = value; }
+        /**
+         * Reads any value into a json DOM. Used for members the schemas leave untyped.
+         */
+        void read(json & value) {
+            const char * first = nullptr;
+            if (!skip_value(first)) return;
+            value = json::parse(first, cur, nullptr, false);
+            if (value.is_discarded()) fail(DecodeErrorKind::OUT_OF_RANGE, "number overflow");
+        }
 
-        std::shared_ptr<bool> get_query_success() const { return query_success; }
-        void set_query_success(std::shared_ptr<bool> value) { this->query_success = value; }
+        /**
+         * Skips the next value. first is set to the start of the value, so that
+         * [first, data() + position()) is its raw text afterwards.
+         */
+        bool skip_value(const char *& first) {
+            const JsonToken token = peek();
+            first = cur;
+            switch (token) {
+                case JsonToken::OBJECT: {
+                    boost::string_view key;
+                    begin_object();
+                    while (next_member(key)) skip_value();
+                    break;
+                }
+                case JsonToken::ARRAY:
+                    begin_array();
+                    while (next_element()) skip_value();
+                    break;
+                case JsonToken::STRING: {
+                    boost::string_view value;
+                    read_string_token(value);
+                    break;
+                }
+                case JsonToken::BOOLEAN: {
+                    bool value;
+                    read(value);
+                    break;
+                }
+                case JsonToken::NULL_VALUE:
+                    read_null();
+                    break;
+                case JsonToken::NUMBER: {
+                    const char * last;
+                    bool is_integer;
+                    read_number_token(first, last, is_integer);
+                    break;
+                }
+                case JsonToken::END:
+                    fail(DecodeErrorKind::SYNTAX_ERROR, "syntax error: unexpected end of input");
+                    break;
+                default:
+                    fail(DecodeErrorKind::SYNTAX_ERROR, "syntax error: invalid literal");
+                    break;
+            }
+            return ok();
+        }
 
-        std::shared_ptr<bool> get_status_has_changed() const { return status_has_changed; }
-        void set_status_has_changed(std::shared_ptr<bool> value) { this->status_has_changed = value; }
+        bool skip_value() {
+            const char * first;
+            return skip_value(first);
+        }
 
-        std::shared_ptr<Query> get_query() const { return query; }
-        void set_query(std::shared_ptr<Query> value) { this->query = value; }
+        /**
+         * Checks that nothing but whitespace follows the decoded value.
+         */
+        void finish() {
+            if (ok() && peek() != JsonToken::END) fail(DecodeErrorKind::SYNTAX_ERROR, "syntax error: unexpected trailing input");
+        }
     };
 
-    /**
-     * Status messages of an elevator
+    inline void read_json(JsonReader & r, std::string & x) { r.read(x); }
+    inline void read_json(JsonReader & r, bool & x) { r.read(x); }
+    inline void read_json(JsonReader & r, int64_t & x) { r.read(x); }
+    inline void read_json(JsonReader & r, double & x) { r.read(x); }
+    inline void read_json(JsonReader & r, json & x) { r.read(x); }
+
+    template <typename T>
+    inline void read_json(JsonReader & r, std::vector<T> & x) {
+        x.clear();
+        if (!r.begin_array()) return;
+        while (r.next_element()) {
+            x.emplace_back();
+            read_json(r, x.back());
+            if (!r.ok()) {
+                r.add_error_index(x.size() - 1);
+                return;
+            }
+        }
+    }
+
+    template <typename T>
+    inline void read_json(JsonReader & r, std::map<std::string, T> & x) {
+        x.clear();
+        if (!r.begin_object()) return;
+        boost::string_view key;
+        while (r.next_member(key)) {
+            std::string name(key.data(), key.size());
+            read_json(r, x[name]);
+            if (!r.ok()) {
+                r.add_error_key(name);
+                return;
+            }
+        }
+    }
+
+    template <typename T>
+    inline void read_json(JsonReader & r, std::shared_ptr<T> & x) {
+        if (r.read_null()) {
+            x.reset();
+            return;
+        }
+        x = std::make_shared<T>();
+        read_json(r, *x);
+    }
+
+    template <typename T>
+    inline void read_json(JsonReader & r, boost::optional<T> & x) {
+        if (r.read_null()) {
+            x = boost::none;
+            return;
+        }
+        x.emplace();
+        read_json(r, *x);
+    }
+
+    /**
+     * Decodes a T from JSON text without building a json DOM. Throws JsonDecodeException if
+     * the text is not valid JSON or does not conform to the schema.
+     */
+    template <typename T>
+    inline T decode(const char * data, size_t size) {
+        JsonReader r(data, size);
+        T x;
+        read_json(r, x);
+        r.finish();
+        if (!r.ok()) throw JsonDecodeException(r.error());
+        return x;
+    }
+
+    template <typename T>
+    inline T decode(const std::string & text) {
+        return decode<T>(text.data(), text.size());
+    }
+
+    /**
+     * Either a value or the error explaining why there is none.
+     */
+    template <typename T, typename E = DecodeError>
+    class Expected {
+        private:
+        boost::variant<T, E> storage;
+
+        public:
+        Expected(T value) : storage(std::move(value)) {}
+        Expected(E error) : storage(std::move(error)) {}
+
+        bool has_value() const { return storage.which() == 0; }
+        explicit operator bool() const { return has_value(); }
+
+        T & value() { return boost::get<T>(storage); }
+        const T & value() const { return boost::get<T>(storage); }
+        T & operator*() { return value(); }
+        const T & operator*() const { return value(); }
+        T * operator->() { return &value(); }
+        const T * operator->() const { return &value(); }
+
+        const E & error() const { return boost::get<E>(storage); }
+    };
+
+    /**
+     * Like decode, but reports failures as a DecodeError instead of throwing, so rejecting
+     * malformed input costs no stack unwinding.
+     */
+    template <typename T>
+    inline Expected<T> try_decode(const char * data, size_t size) {
+        JsonReader r(data, size);
+        T x;
+        read_json(r, x);
+        r.finish();
+        if (!r.ok()) return r.get_error();
+        return Expected<T>(std::move(x));
+    }
+
+    template <typename T>
+    inline Expected<T> try_decode(const std::string & text) {
+        return try_decode<T>(text.data(), text.size());
+    }
+}
+#endif
+
+#ifndef QUICKTYPE_LAZY_HELPER
+#define QUICKTYPE_LAZY_HELPER
+namespace quicktype {
+    /**
+     * A T kept as the raw JSON text it was read from and decoded on first access. Decoding
+     * happens once even if several threads access the value concurrently; copies share the
+     * text and the decoded value.
+     */
+    template <typename T>
+    class Lazy {
+        private:
+        struct State {
+            std::string text;
+            std::once_flag once;
+            T value;
+            bool failed = false;
+            std::string error;
+        };
+        std::shared_ptr<State> state;
+
+        static const T & empty() {
+            static const T value {};
+            return value;
+        }
+
+        static const std::string & empty_text() {
+            static const std::string text;
+            return text;
+        }
+
+        public:
+        Lazy() = default;
+        explicit Lazy(std::string text) : state(std::make_shared<State>()) { state->text = std::move(text); }
+
+        bool has_text() const { return state != nullptr; }
+
+        /**
+         * The JSON text of the value as it was received.
+         */
+        const std::string & get_text() const { return state ? state->text : empty_text(); }
+
+        /**
+         * The decoded value. Throws JsonDecodeException if the text does not decode to a T;
+         * a default constructed T is returned if there is no text.
+         */
+        const T & get() const {
+            if (!state) return empty();
+            State & s = *state;
+            std::call_once(s.once, [&s] {
+                JsonReader r(s.text);
+                read_json(r, s.value);
+                r.finish();
+                s.failed = !r.ok();
+                if (s.failed) s.error = r.error();
+            });
+            if (s.failed) throw JsonDecodeException(s.error);
+            return s.value;
+        }
+    };
+
+    /**
+     * Retains the raw text of the next value without decoding it. The text is still checked
+     * to be well-formed JSON.
+     */
+    template <typename T>
+    inline void read_json(JsonReader & r, Lazy<T> & x) {
+        const char * first = nullptr;
+        if (r.skip_value(first)) x = Lazy<T>(std::string(first, r.data() + r.position()));
+    }
+}
+#endif
+
+#ifndef QUICKTYPE_WRITER_HELPER
+#define QUICKTYPE_WRITER_HELPER
+namespace quicktype {
+    /**
+     * How JsonWriter writes optional members that are absent: as null, like to_json and
+     * json::dump() do, or not at all. Both forms decode to the same objects.
+     */
+    enum class OptionalMembers : int { OMIT_ABSENT, WRITE_NULL };
+
+    /**
+     * How JsonWriter writes doubles: as json::dump() does, or as the shortest decimal that
+     * reads back as the same value. SHORTEST is faster for the typical coordinates and time
+     * stamps, and where nlohmann's Grisu2 is a digit or two longer (0.32467472000000003 for
+     * 0.32467472) its output is shorter than dump()'s. Both read back as the same doubles.
+     */
+    enum class DoubleNotation : int { DUMP, SHORTEST };
+
+    /**
+     * Writes JSON text straight from the typed classes into a reusable buffer. The generated
+     * write_json functions produce the bytes json(x).dump() would, without building the
+     * json DOM: keys in sorted order, no whitespace, nlohmann's string escaping and number
+     * notation. With OptionalMembers::OMIT_ABSENT absent optional and untyped null members
+     * are left out instead, and with DoubleNotation::SHORTEST doubles are written in their
+     * shortest form, for smaller messages.
+     */
+    class JsonWriter {
+        private:
+        std::string out;
+        OptionalMembers optional_members;
+        DoubleNotation double_notation;
+
+        /**
+         * Formats value the way nlohmann does for the common case of a number with at most 15
+         * significant digits in fixed notation (magnitudes 1e-4 to 1e15): scaled by a power of
+         * ten it is an integer m, and m / 10^k, trailing zeros dropped, is the shortest decimal
+         * that reads back as value. Reading back is checked with one exact division (Clinger's
+         * fast path). Returns nullptr if value is not such a number.
+         */
+        static char * format_short_double(char * out, double value) {
+            static const double powers[] = {
+                1e-4, 1e-3, 1e-2, 1e-1, 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+                1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18
+            };
+            const double * const tens = powers + 4;
+            const double magnitude = std::fabs(value);
+            if (!(magnitude >= 1e-4 && magnitude < 1e15)) return nullptr;
+            // floor(log10(magnitude)), estimated from the binary exponent and corrected
+            uint64_t bits;
+            std::memcpy(&bits, &magnitude, sizeof(bits));
+            const int binary = static_cast<int>(bits >> 52) - 1023;
+            int decimal = binary >= 0 ? binary * 1233 >> 12 : -((-binary * 1233 + 4095) >> 12);
+            if (magnitude >= tens[decimal + 1]) decimal++;
+            int scale = 14 - decimal;
+            const double scaled = magnitude * tens[scale];
+            uint64_t digits = static_cast<uint64_t>(scaled);
+            if (static_cast<double>(digits) != scaled) return nullptr;
+            if (digits % 10000 == 0) {
+                while (scale >= 8 && digits % 100000000 == 0) {
+                    digits /= 100000000;
+                    scale -= 8;
+                }
+                if (scale >= 4 && digits % 10000 == 0) {
+                    digits /= 10000;
+                    scale -= 4;
+                }
+            }
+            while (scale > 0 && digits % 10 == 0) {
+                digits /= 10;
+                scale--;
+            }
+            if (static_cast<double>(digits) / tens[scale] != magnitude) return nullptr;
+
+            if (value < 0) *out++ = '-';
+            uint64_t unit = 1;
+            for (int i = 0; i < scale; i++) unit *= 10;
+            char buffer[20];
+            char * const last = buffer + sizeof(buffer);
+            char * first = last;
+            uint64_t whole = digits / unit;
+            do {
+                *--first = static_cast<char>('0' + whole % 10);
+                whole /= 10;
+            } while (whole != 0);
+            std::memcpy(out, first, static_cast<size_t>(last - first));
+            out += last - first;
+            *out++ = '.';
+            if (scale == 0) {
+                *out++ = '0';
+                return out;
+            }
+            uint64_t fraction = digits % unit;
+            for (int i = scale - 1; i >= 0; i--) {
+                out[i] = static_cast<char>('0' + fraction % 10);
+                fraction /= 10;
+            }
+            return out + scale;
+        }
+
+        public:
+        explicit JsonWriter(OptionalMembers optional_members = OptionalMembers::WRITE_NULL, DoubleNotation double_notation = DoubleNotation::DUMP)
+            : optional_members(optional_members), double_notation(double_notation) {}
+
+        OptionalMembers get_optional_members() const { return optional_members; }
+        void set_optional_members(OptionalMembers value) { this->optional_members = value; }
+
+        DoubleNotation get_double_notation() const { return double_notation; }
+        void set_double_notation(DoubleNotation value) { this->double_notation = value; }
+
+        /**
+         * Empties the buffer but keeps its capacity for the next message.
+         */
+        void clear() { out.clear(); }
+        void reserve(size_t capacity) { out.reserve(capacity); }
+        size_t size() const { return out.size(); }
+        const std::string & str() const { return out; }
+        std::string release() { return std::move(out); }
+
+        void raw(char c) { out += c; }
+
+        template <size_t N>
+        void raw(const char (&text)[N]) { out.append(text, N - 1); }
+
+        /**
+         * Appends text as it is, for JSON rendered ahead of time.
+         */
+        void raw(boost::string_view text) { out.append(text.data(), text.size()); }
+
+        /**
+         * Writes a member key given as ",\"key\":", dropping the comma for the first member
+         * of an object.
+         */
+        template <size_t N>
+        void key(const char (&text)[N]) {
+            if (out.back() == '{') out.append(text + 1, N - 2);
+            else out.append(text, N - 1);
+        }
+
+        /**
+         * Whether an optional member with this value is written.
+         */
+        template <typename T>
+        bool writes(const T & value) const { return optional_members == OptionalMembers::WRITE_NULL || static_cast<bool>(value); }
+        bool writes(const json & value) const { return optional_members == OptionalMembers::WRITE_NULL || !value.is_null(); }
+
+        void write_null() { out.append("null", 4); }
+
+        void write_bool(bool value) {
+            if (value) out.append("true", 4);
+            else out.append("false", 5);
+        }
+
+        void write_integer(int64_t value) {
+            char buffer[24];
+            char * last = buffer + sizeof(buffer);
+            char * first = last;
+            uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+            do {
+                *--first = static_cast<char>('0' + magnitude % 10);
+                magnitude /= 10;
+            } while (magnitude != 0);
+            if (value < 0) *--first = '-';
+            out.append(first, last);
+        }
+
+        void write_double(double value) {
+            if (!std::isfinite(value)) {
+                write_null();
+                return;
+            }
+            char buffer[64];
+            char * last = double_notation == DoubleNotation::SHORTEST ? format_short_double(buffer, value) : nullptr;
+            if (last == nullptr) last = nlohmann::detail::to_chars(buffer, buffer + sizeof(buffer), value);
+            out.append(buffer, last);
+        }
+
+        void write_string(boost::string_view value) {
+            static const char hex[] = "0123456789abcdef";
+            const char * p = value.data();
+            const char * last = p + value.size();
+            const char * run = p;
+            out += '"';
+            while (p < last) {
+                const unsigned char c = static_cast<unsigned char>(*p);
+                if (c >= 0x20 && c < 0x80 && c != '"' && c != '\\') {
+                    p++;
+                    continue;
+                }
+                out.append(run, p);
+                if (c >= 0x80) {
+                    const size_t length = utf8_sequence_length(reinterpret_cast<const unsigned char *>(p), reinterpret_cast<const unsigned char *>(last));
+                    // let nlohmann raise its usual type_error for invalid UTF-8
+                    if (length == 0) (void)json(value.to_string()).dump();
+                    out.append(p, length);
+                    p += length;
+                } else {
+                    out += '\\';
+                    switch (c) {
+                        case '"': out += '"'; break;
+                        case '\\': out += '\\'; break;
+                        case '\b': out += 'b'; break;
+                        case '\f': out += 'f'; break;
+                        case '\n': out += 'n'; break;
+                        case '\r': out += 'r'; break;
+                        case '\t': out += 't'; break;
+                        default:
+                            out.append("u00", 3);
+                            out += hex[c >> 4];
+                            out += hex[c & 0xF];
+                            break;
+                    }
+                    p++;
+                }
+                run = p;
+            }
+            out.append(run, p);
+            out += '"';
+        }
+
+        /**
+         * Writes a json value, used for members the schemas leave untyped.
+         */
+        void write_value(const json & value) { out += value.dump(); }
+    };
+
+    inline void write_json(JsonWriter & w, const std::string & x) { w.write_string(x); }
+    inline void write_json(JsonWriter & w, bool x) { w.write_bool(x); }
+    inline void write_json(JsonWriter & w, int64_t x) { w.write_integer(x); }
+    inline void write_json(JsonWriter & w, double x) { w.write_double(x); }
+    inline void write_json(JsonWriter & w, const json & x) { w.write_value(x); }
+
+    template <typename T>
+    inline void write_json(JsonWriter & w, const std::vector<T> & x) {
+        w.raw('[');
+        for (size_t i = 0; i < x.size(); i++) {
+            if (i != 0) w.raw(',');
+            write_json(w, x[i]);
+        }
+        w.raw(']');
+    }
+
+    template <typename T>
+    inline void write_json(JsonWriter & w, const std::map<std::string, T> & x) {
+        w.raw('{');
+        bool first = true;
+        for (const auto & member : x) {
+            if (!first) w.raw(',');
+            first = false;
+            w.write_string(member.first);
+            w.raw(':');
+            write_json(w, member.second);
+        }
+        w.raw('}');
+    }
+
+    template <typename T>
+    inline void write_json(JsonWriter & w, const std::shared_ptr<T> & x) {
+        if (x) write_json(w, *x);
+        else w.write_null();
+    }
+
+    template <typename T>
+    inline void write_json(JsonWriter & w, const boost::optional<T> & x) {
+        if (x) write_json(w, *x);
+        else w.write_null();
+    }
+
+    /**
+     * Encodes x to JSON text, by default byte-identical to json(x).dump(). The output buffer
+     * is reserved from the size of the last T encoded on this thread, so encoding messages of
+     * a steady size does not reallocate. Use a JsonWriter directly to reuse one buffer.
+     */
+    template <typename T>
+    inline std::string encode(const T & x, OptionalMembers optional_members = OptionalMembers::WRITE_NULL, DoubleNotation double_notation = DoubleNotation::DUMP) {
+        static thread_local size_t size_hint = 0;
+        JsonWriter w(optional_members, double_notation);
+        w.reserve(size_hint);
+        write_json(w, x);
+        size_hint = w.size() + w.size() / 8;
+        return w.release();
+    }
+}
+#endif
+
+#ifndef QUICKTYPE_BINARY_HELPER
+#define QUICKTYPE_BINARY_HELPER
+namespace quicktype {
+    /**
+     * MessagePack and CBOR forms of the schema classes. They go through nlohmann's binary
+     * adapters from the same json representation as to_json/from_json, so they round-trip
+     * losslessly with the JSON form: json::from_msgpack(encode_msgpack(x)) == json(x).
+     * Decoding throws the same exceptions as json::parse(...).get<T>().
+     */
+    template <typename T>
+    inline std::vector<uint8_t> encode_msgpack(const T & x) {
+        return json::to_msgpack(json(x));
+    }
+
+    template <typename T>
+    inline T decode_msgpack(const uint8_t * data, size_t size) {
+        return json::from_msgpack(data, data + size).template get<T>();
+    }
+
+    template <typename T>
+    inline T decode_msgpack(const std::vector<uint8_t> & bytes) {
+        return decode_msgpack<T>(bytes.data(), bytes.size());
+    }
+
+    template <typename T>
+    inline std::vector<uint8_t> encode_cbor(const T & x) {
+        return json::to_cbor(json(x));
+    }
+
+    template <typename T>
+    inline T decode_cbor(const uint8_t * data, size_t size) {
+        return json::from_cbor(data, data + size).template get<T>();
+    }
+
+    template <typename T>
+    inline T decode_cbor(const std::vector<uint8_t> & bytes) {
+        return decode_cbor<T>(bytes.data(), bytes.size());
+    }
+}
+#endif
+
+#ifndef QUICKTYPE_PACKED_HELPER
+#define QUICKTYPE_PACKED_HELPER
+namespace quicktype {
+    /**
+     * Version of the packed format, written as the first byte of every packed message.
+     */
+    const uint8_t packed_format_version = 1;
+
+    /**
+     * Identifies a top-level schema class in packed messages. Every generated root class has a
+     * specialization with a small, fixed tag; tags are never reused.
+     */
+    template <typename T>
+    struct PackedSchema;
+
+    class PackedDecodeException : public std::runtime_error {
+        public:
+        PackedDecodeException(const std::string &  msg) : std::runtime_error(msg) {}
+    };
+
+    /**
+     * Writer for the packed binary format. Members carry no keys: they are written in member
+     * order, with a bitmap up front saying which optional members are present. Integers are
+     * zigzag varints, doubles 8 little-endian bytes, strings a varint length and their UTF-8
+     * bytes, enums their ordinal (nothing at all for single-value enums), UUIDs their 16 bytes
+     * and untyped members length-prefixed MessagePack.
+     */
+    class PackedWriter {
+        private:
+        std::vector<uint8_t> out;
+
+
+        public:
+        PackedWriter() = default;
+
+        void clear() { out.clear(); }
+        void reserve(size_t size) { out.reserve(size); }
+        size_t size() const { return out.size(); }
+        const std::vector<uint8_t> & bytes() const { return out; }
+        std::vector<uint8_t> release() { return std::move(out); }
+
+        void write_u8(uint8_t value) { out.push_back(value); }
+
+        void write_bytes(const uint8_t * bytes, size_t size) { out.insert(out.end(), bytes, bytes + size); }
+
+        void write_varint(uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        /**
+         * Writes the presence bitmap of a class with this many optional members.
+         */
+        void write_bitmap(uint32_t value, size_t members) {
+            for (size_t i = 0; i < (members + 7) / 8; i++) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+
+        void write_bool(bool value) { out.push_back(value ? 1 : 0); }
+
+        void write_integer(int64_t value) {
+            write_varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+        }
+
+        void write_double(double value) {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            for (int i = 0; i < 8; i++) out.push_back(static_cast<uint8_t>(bits >> (8 * i)));
+        }
+
+        void write_string(boost::string_view value) {
+            write_varint(value.size());
+            out.insert(out.end(), value.begin(), value.end());
+        }
+
+        void write_value(const json & value) {
+            std::vector<uint8_t> bytes = json::to_msgpack(value);
+            write_varint(bytes.size());
+            out.insert(out.end(), bytes.begin(), bytes.end());
+        }
+    };
+
+    /**
+     * Reader for the packed binary format. Like JsonReader it never throws: the first error is
+     * recorded with the path of the member being read and every later call is a no-op.
+     */
+    class PackedReader {
+        private:
+        const uint8_t * begin;
+        const uint8_t * cur;
+        const uint8_t * end;
+        bool failed = false;
+        DecodeErrorKind error_kind = DecodeErrorKind::SYNTAX_ERROR;
+        std::string error_message;
+        std::string error_path;
+        size_t error_offset = 0;
+
+        static bool is_utf8(const unsigned char * p, const unsigned char * last) {
+            while (p < last) {
+                if (last - p >= 8) {
+                    uint64_t block;
+                    std::memcpy(&block, p, sizeof(block));
+                    if (!(block & 0x8080808080808080u)) {
+                        p += 8;
+                        continue;
+                    }
+                }
+                if (*p < 0x80) {
+                    p++;
+                    continue;
+                }
+                const size_t length = utf8_sequence_length(p, last);
+                if (length == 0) return false;
+                p += length;
+            }
+            return true;
+        }
+
+        static bool is_utf8(const std::string & text) {
+            const unsigned char * p = reinterpret_cast<const unsigned char *>(text.data());
+            return is_utf8(p, p + text.size());
+        }
+
+        /**
+         * Whether a MessagePack value has a JSON form that decodes back to it: no binary
+         * values, non-finite numbers or strings that are not UTF-8.
+         */
+        static bool is_json_value(const json & value) {
+            switch (value.type()) {
+                case json::value_t::string: return is_utf8(value.get_ref<const std::string &>());
+                case json::value_t::number_float: return std::isfinite(value.get<double>());
+                case json::value_t::binary: return false;
+                case json::value_t::array:
+                    for (const auto & element : value) {
+                        if (!is_json_value(element)) return false;
+                    }
+                    return true;
+                case json::value_t::object:
+                    for (const auto & member : value.items()) {
+                        if (!is_utf8(member.key()) || !is_json_value(member.value())) return false;
+                    }
+                    return true;
+                default: return true;
+            }
+        }
+
+        bool available(size_t size) {
+            if (!ok()) return false;
+            if (static_cast<size_t>(end - cur) < size) {
+                fail(DecodeErrorKind::SYNTAX_ERROR, "unexpected end of packed input");
+                return false;
+            }
+            return true;
+        }
+
+        public:
+        PackedReader(const uint8_t * data, size_t size) : begin(data), cur(data), end(data + size) {}
+        explicit PackedReader(const std::vector<uint8_t> & bytes) : PackedReader(bytes.data(), bytes.size()) {}
+
+        bool ok() const { return !failed; }
+        size_t position() const { return static_cast<size_t>(cur - begin); }
+        const uint8_t * current() const { return cur; }
+        size_t remaining() const { return static_cast<size_t>(end - cur); }
+
+        void fail(DecodeErrorKind kind, const std::string & message) {
+            if (ok()) {
+                failed = true;
+                error_kind = kind;
+                error_message = message;
+                error_offset = position();
+            }
+            cur = end;
+        }
+
+        /**
+         * Prepends a member key to the path of the recorded error, as a JSON pointer into the
+         * message's JSON form.
+         */
+        void add_error_key(boost::string_view key) {
+            std::string component = "/";
+            for (const char c : key) {
+                if (c == '~') component += "~0";
+                else if (c == '/') component += "~1";
+                else component += c;
+            }
+            error_path.insert(0, component);
+        }
+
+        void add_error_index(size_t index) {
+            error_path.insert(0, "/" + std::to_string(index));
+        }
+
+        DecodeError get_error() const { return DecodeError(error_kind, error_message, error_path, error_offset); }
+
+        /**
+         * The recorded error as text, or an empty string if nothing failed.
+         */
+        std::string error() const { return failed ? get_error().to_string() : std::string(); }
+
+        uint8_t read_u8() {
+            if (!available(1)) return 0;
+            return *cur++;
+        }
+
+        /**
+         * Consumes size bytes and returns them, or nullptr if the input is shorter.
+         */
+        const uint8_t * consume(size_t size) {
+            if (!available(size)) return nullptr;
+            const uint8_t * bytes = cur;
+            cur += size;
+            return bytes;
+        }
+
+        uint64_t read_varint() {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                if (!available(1)) return 0;
+                const uint8_t byte = *cur++;
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return value;
+            }
+            fail(DecodeErrorKind::SYNTAX_ERROR, "varint is too long");
+            return 0;
+        }
+
+        /**
+         * Reads a count of items that take at least one byte each, rejecting counts the rest
+         * of the input cannot hold before anything is allocated for them.
+         */
+        size_t read_size() {
+            const uint64_t size = read_varint();
+            if (!ok()) return 0;
+            if (size > static_cast<uint64_t>(end - cur)) {
+                fail(DecodeErrorKind::SYNTAX_ERROR, "unexpected end of packed input");
+                return 0;
+            }
+            return static_cast<size_t>(size);
+        }
+
+        uint32_t read_bitmap(size_t members) {
+            const size_t bytes = (members + 7) / 8;
+            if (!available(bytes)) return 0;
+            uint32_t value = 0;
+            for (size_t i = 0; i < bytes; i++) value |= static_cast<uint32_t>(*cur++) << (8 * i);
+            if (value >> members) fail(DecodeErrorKind::SYNTAX_ERROR, "presence bitmap has unknown members");
+            return value;
+        }
+
+        void read(bool & value) {
+            const uint8_t byte = read_u8();
+            if (byte > 1) fail(DecodeErrorKind::TYPE_MISMATCH, "type must be boolean");
+            value = byte == 1;
+        }
+
+        void read(int64_t & value) {
+            const uint64_t zigzag = read_varint();
+            value = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+        }
+
+        void read(double & value) {
+            if (!available(8)) return;
+            uint64_t bits = 0;
+            for (int i = 0; i < 8; i++) bits |= static_cast<uint64_t>(cur[i]) << (8 * i);
+            cur += 8;
+            std::memcpy(&value, &bits, sizeof(value));
+            if (!std::isfinite(value)) fail(DecodeErrorKind::OUT_OF_RANGE, "number is not finite");
+        }
+
+        /**
+         * Reads a string as a view into the input.
+         */
+        void read(boost::string_view & value) {
+            const size_t size = read_size();
+            if (!ok()) return;
+            if (!is_utf8(cur, cur + size)) {
+                fail(DecodeErrorKind::SYNTAX_ERROR, "invalid UTF-8 byte in string");
+                return;
+            }
+            value = boost::string_view(reinterpret_cast<const char *>(cur), size);
+            cur += size;
+        }
+
+        void read(std::string & value) {
+            boost::string_view text;
+            read(text);
+            if (ok()) value.assign(text.data(), text.size());
+        }
+
+        /**
+         * Reads a UUID member's marker, then either its 16 bytes into bytes or, for marker 0,
+         * its string into text. Returns the marker.
+         */
+        uint8_t read_uuid(const uint8_t *& bytes, boost::string_view & text) {
+            const uint8_t form = read_u8();
+            if (!ok()) return 0;
+            if (form == 0) read(text);
+            else if (form > 2) fail(DecodeErrorKind::SYNTAX_ERROR, "invalid UUID marker");
+            else bytes = consume(16);
+            return form;
+        }
+
+        void read(json & value) {
+            const size_t size = read_size();
+            if (!ok()) return;
+            value = json::from_msgpack(cur, cur + size, true, false);
+            if (value.is_discarded() || !is_json_value(value)) {
+                fail(DecodeErrorKind::SYNTAX_ERROR, "invalid MessagePack value");
+                return;
+            }
+            cur += size;
+        }
+
+        /**
+         * Reads a message's envelope and checks that it holds the schema with this tag.
+         */
+        void begin_message(uint32_t tag) {
+            const uint8_t version = read_u8();
+            if (ok() && version != packed_format_version) {
+                fail(DecodeErrorKind::SYNTAX_ERROR, "unsupported packed format version " + std::to_string(version));
+                return;
+            }
+            const uint64_t schema = read_varint();
+            if (ok() && schema != tag) fail(DecodeErrorKind::TYPE_MISMATCH, "packed message has schema tag " + std::to_string(schema) + ", expected " + std::to_string(tag));
+        }
+
+        void finish() {
+            if (ok() && cur != end) fail(DecodeErrorKind::SYNTAX_ERROR, "unexpected trailing packed input");
+        }
+    };
+
+    inline void write_packed(PackedWriter & w, const std::string & x) { w.write_string(x); }
+    inline void write_packed(PackedWriter & w, bool x) { w.write_bool(x); }
+    inline void write_packed(PackedWriter & w, int64_t x) { w.write_integer(x); }
+    inline void write_packed(PackedWriter & w, double x) { w.write_double(x); }
+    inline void write_packed(PackedWriter & w, const json & x) { w.write_value(x); }
+
+    template <typename T>
+    inline void write_packed(PackedWriter & w, const std::vector<T> & x) {
+        w.write_varint(x.size());
+        for (const auto & element : x) write_packed(w, element);
+    }
+
+    template <typename T>
+    inline void write_packed(PackedWriter & w, const std::map<std::string, T> & x) {
+        w.write_varint(x.size());
+        for (const auto & member : x) {
+            w.write_string(member.first);
+            write_packed(w, member.second);
+        }
+    }
+
+    inline void read_packed(PackedReader & r, std::string & x) { r.read(x); }
+    inline void read_packed(PackedReader & r, bool & x) { r.read(x); }
+    inline void read_packed(PackedReader & r, int64_t & x) { r.read(x); }
+    inline void read_packed(PackedReader & r, double & x) { r.read(x); }
+    inline void read_packed(PackedReader & r, json & x) { r.read(x); }
+
+    template <typename T>
+    inline void read_packed(PackedReader & r, std::vector<T> & x) {
+        const size_t size = r.read_size();
+        x.clear();
+        x.reserve(size);
+        for (size_t i = 0; i < size; i++) {
+            x.emplace_back();
+            read_packed(r, x.back());
+            if (!r.ok()) {
+                r.add_error_index(i);
+                return;
+            }
+        }
+    }
+
+    template <typename T>
+    inline void read_packed(PackedReader & r, std::map<std::string, T> & x) {
+        const size_t size = r.read_size();
+        x.clear();
+        for (size_t i = 0; i < size; i++) {
+            std::string name;
+            r.read(name);
+            read_packed(r, x[name]);
+            if (!r.ok()) {
+                r.add_error_key(name);
+                return;
+            }
+        }
+    }
+
+    /**
+     * Makes an optional member hold a default-constructed value and returns it.
+     */
+    template <typename T>
+    inline T & emplace_optional(std::shared_ptr<T> & x) {
+        x = std::make_shared<T>();
+        return *x;
+    }
+
+    template <typename T>
+    inline T & emplace_optional(boost::optional<T> & x) {
+        x.emplace();
+        return *x;
+    }
+
+    /**
+     * Encodes x to the packed binary format: a format version byte, the schema's tag as a
+     * varint, then the message itself.
+     */
+    template <typename T>
+    inline std::vector<uint8_t> encode_packed(const T & x) {
+        static thread_local size_t size_hint = 0;
+        PackedWriter w;
+        w.reserve(size_hint);
+        w.write_u8(packed_format_version);
+        w.write_varint(PackedSchema<T>::tag);
+        write_packed(w, x);
+        size_hint = w.size();
+        return w.release();
+    }
+
+    template <typename T>
+    inline Expected<T> try_decode_packed(const uint8_t * data, size_t size) {
+        PackedReader r(data, size);
+        T x;
+        r.begin_message(PackedSchema<T>::tag);
+        if (r.ok()) read_packed(r, x);
+        r.finish();
+        if (!r.ok()) return r.get_error();
+        return Expected<T>(std::move(x));
+    }
+
+    template <typename T>
+    inline Expected<T> try_decode_packed(const std::vector<uint8_t> & bytes) {
+        return try_decode_packed<T>(bytes.data(), bytes.size());
+    }
+
+    /**
+     * Decodes a T from the packed binary format. Throws PackedDecodeException if the bytes
+     * are truncated, hold another schema or do not conform to this one.
+     */
+    template <typename T>
+    inline T decode_packed(const uint8_t * data, size_t size) {
+        Expected<T> x = try_decode_packed<T>(data, size);
+        if (!x) throw PackedDecodeException(x.error().to_string());
+        return std::move(*x);
+    }
+
+    template <typename T>
+    inline T decode_packed(const std::vector<uint8_t> & bytes) {
+        return decode_packed<T>(bytes.data(), bytes.size());
+    }
+
+    /**
+     * Schema tag of a packed message, or 0 if the bytes do not start like one, so receivers
+     * can pick the class to decode it with.
+     */
+    inline uint32_t peek_packed_schema(const uint8_t * data, size_t size) {
+        PackedReader r(data, size);
+        if (r.read_u8() != packed_format_version) return 0;
+        const uint64_t tag = r.read_varint();
+        if (!r.ok() || tag > UINT32_MAX) return 0;
+        return static_cast<uint32_t>(tag);
+    }
+
+    /**
+     * JSON bridge for peers that speak JSON: converts a packed T to the JSON text encode()
+     * would produce for it, and JSON text to a packed T. The text that comes back is the
+     * canonical form of the message rather than the received bytes: members in schema order,
+     * no insignificant whitespace, and numbers, ids and time stamps as their types write them
+     * (see JsonWriter, Uuid and Instant). Text in that form crosses the bridge unchanged.
+     */
+    template <typename T>
+    inline std::string packed_to_json(const uint8_t * data, size_t size, OptionalMembers optional_members = OptionalMembers::WRITE_NULL) {
+        return encode(decode_packed<T>(data, size), optional_members);
+    }
+
+    template <typename T>
+    inline std::string packed_to_json(const std::vector<uint8_t> & bytes, OptionalMembers optional_members = OptionalMembers::WRITE_NULL) {
+        return packed_to_json<T>(bytes.data(), bytes.size(), optional_members);
+    }
+
+    template <typename T>
+    inline std::vector<uint8_t> json_to_packed(const char * data, size_t size) {
+        return encode_packed(decode<T>(data, size));
+    }
+
+    template <typename T>
+    inline std::vector<uint8_t> json_to_packed(const std::string & text) {
+        return json_to_packed<T>(text.data(), text.size());
+    }
+}
+#endif
+
+#ifndef QUICKTYPE_VIEW_HELPER
+#define QUICKTYPE_VIEW_HELPER
+namespace quicktype {
+    /**
+     * Names a member type for the overloads that skip and view packed values.
+     */
+    template <typename T>
+    struct PackedType {};
+
+    /**
+     * Skips the value at r, checking it. Numbers, booleans and enums are read and dropped;
+     * the other types have overloads that skip them without allocating.
+     */
+    template <typename T>
+    inline void skip_packed(PackedReader & r, PackedType<T>) {
+        T value = T();
+        read_packed(r, value);
+    }
+
+    inline void skip_packed(PackedReader & r, PackedType<std::string>) {
+        boost::string_view value;
+        r.read(value);
+    }
+
+    inline void skip_packed(PackedReader & r, PackedType<json>) {
+        r.consume(r.read_size());
+    }
+
+    template <typename T>
+    inline void skip_packed(PackedReader & r, PackedType<std::vector<T>>) {
+        const size_t size = r.read_size();
+        for (size_t i = 0; i < size && r.ok(); i++) {
+            skip_packed(r, PackedType<T>());
+            if (!r.ok()) r.add_error_index(i);
+        }
+    }
+
+    template <typename T>
+    inline void skip_packed(PackedReader & r, PackedType<std::map<std::string, T>>) {
+        const size_t size = r.read_size();
+        for (size_t i = 0; i < size && r.ok(); i++) {
+            boost::string_view name;
+            r.read(name);
+            skip_packed(r, PackedType<T>());
+            if (!r.ok()) r.add_error_key(name);
+        }
+    }
+
+    /**
+     * Reads the value at r. Numbers, booleans and enums are returned by value and untyped
+     * members decoded; the other types have overloads returning views.
+     */
+    template <typename T>
+    inline T read_view(PackedReader & r, PackedType<T>) {
+        T value = T();
+        read_packed(r, value);
+        return value;
+    }
+
+    inline boost::string_view read_view(PackedReader & r, PackedType<std::string>) {
+        boost::string_view value;
+        r.read(value);
+        return value;
+    }
+
+    /**
+     * Read-only view of a packed list. Elements are found by skipping the ones before them,
+     * so iterate rather than index into long lists.
+     */
+    template <typename T>
+    class PackedListView {
+        private:
+        const uint8_t * data = nullptr;
+        size_t length = 0;
+        size_t count = 0;
+
+        public:
+        using value_type = decltype(read_view(std::declval<PackedReader &>(), PackedType<T>()));
+
+        class const_iterator {
+            private:
+            PackedReader r;
+            size_t remaining;
+
+            public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = PackedListView::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = value_type;
+
+            const_iterator(const uint8_t * data, size_t length, size_t remaining) : r(data, length), remaining(remaining) {}
+
+            value_type operator*() const {
+                PackedReader element = r;
+                return read_view(element, PackedType<T>());
+            }
+
+            const_iterator & operator++() {
+                skip_packed(r, PackedType<T>());
+                remaining--;
+                return *this;
+            }
+
+            bool operator==(const const_iterator & other) const { return remaining == other.remaining; }
+            bool operator!=(const const_iterator & other) const { return remaining != other.remaining; }
+        };
+
+        PackedListView() = default;
+        PackedListView(const uint8_t * data, size_t length, size_t count) : data(data), length(length), count(count) {}
+
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        const_iterator begin() const { return const_iterator(data, length, count); }
+        const_iterator end() const { return const_iterator(data, length, 0); }
+
+        value_type operator[](size_t index) const {
+            PackedReader r(data, length);
+            for (size_t i = 0; i < index; i++) skip_packed(r, PackedType<T>());
+            return read_view(r, PackedType<T>());
+        }
+    };
+
+    template <typename T>
+    inline PackedListView<T> read_view(PackedReader & r, PackedType<std::vector<T>>) {
+        const size_t size = r.read_size();
+        if (!r.ok()) return PackedListView<T>();
+        return PackedListView<T>(r.current(), r.remaining(), size);
+    }
+
+    /**
+     * Checks the structure of a packed T without decoding it and returns a read-only view of
+     * it, whose getters have the same names as T's and read each member in place from the
+     * buffer. The view holds no copy of the buffer, which must outlive it. Member constraints
+     * and untyped members are only checked by decode_packed.
+     */
+    template <typename T>
+    inline Expected<typename PackedSchema<T>::View> try_view_packed(const uint8_t * data, size_t size) {
+        PackedReader r(data, size);
+        r.begin_message(PackedSchema<T>::tag);
+        const uint8_t * body = r.current();
+        if (r.ok()) skip_packed(r, PackedType<T>());
+        r.finish();
+        if (!r.ok()) return r.get_error();
+        return typename PackedSchema<T>::View(body, static_cast<size_t>(data + size - body));
+    }
+
+    template <typename T>
+    inline Expected<typename PackedSchema<T>::View> try_view_packed(const std::vector<uint8_t> & bytes) {
+        return try_view_packed<T>(bytes.data(), bytes.size());
+    }
+
+    /**
+     * Like try_view_packed, but throws PackedDecodeException if the bytes are not a packed T.
+     */
+    template <typename T>
+    inline typename PackedSchema<T>::View view_packed(const uint8_t * data, size_t size) {
+        Expected<typename PackedSchema<T>::View> view = try_view_packed<T>(data, size);
+        if (!view) throw PackedDecodeException(view.error().to_string());
+        return *view;
+    }
+
+    template <typename T>
+    inline typename PackedSchema<T>::View view_packed(const std::vector<uint8_t> & bytes) {
+        return view_packed<T>(bytes.data(), bytes.size());
+    }
+}
+#endif
+
+#ifndef QUICKTYPE_UUID_HELPER
+#define QUICKTYPE_UUID_HELPER
+namespace quicktype {
+    /**
+     * A UUID (RFC 4122) held as its 16 bytes, for the id members the schemas constrain to the
+     * UUID pattern. Parsing accepts either case and remembers the case of every hex digit, so
+     * a parsed id formats back to the text it was read from; ids made from numbers or bytes
+     * format in lower case. Comparison and hashing ignore case, and ordering is that of the
+     * lower-case text, so ordered containers list ids as before.
+     */
+    class Uuid {
+        private:
+        uint64_t high = 0;
+        uint64_t low = 0;
+        // bit 31 - i is set if hex digit i is an upper-case letter
+        uint32_t upper = 0;
+
+        /**
+         * Value of each hex digit, or -1 for any other character.
+         */
+        static const int8_t * hex_values() {
+            static const struct Table {
+                int8_t values[256];
+                Table() {
+                    for (int c = 0; c < 256; c++) values[c] = -1;
+                    for (int c = 0; c < 10; c++) values['0' + c] = static_cast<int8_t>(c);
+                    for (int c = 0; c < 6; c++) values['a' + c] = values['A' + c] = static_cast<int8_t>(10 + c);
+                }
+            } table;
+            return table.values;
+        }
+
+        /**
+         * Reads the 2 * count hex digits at text as a big-endian number, or returns false.
+         * Shifts one bit per digit into upper, set for upper-case letters.
+         */
+        static bool parse_hex(const char * text, int count, uint64_t & value, uint32_t & upper) {
+            const int8_t * values = hex_values();
+            int bad = 0;
+            for (int i = 0; i < 2 * count; i++) {
+                const int8_t h = values[static_cast<uint8_t>(text[i])];
+                bad |= h;
+                value = value << 4 | static_cast<uint64_t>(h & 0xF);
+                upper = upper << 1 | (text[i] >= 'A' && text[i] <= 'F' ? 1u : 0u);
+            }
+            return bad >= 0;
+        }
+
+        /**
+         * One bit per hex digit as in upper, set for the digits that are letters.
+         */
+        uint32_t letter_digits() const {
+            uint32_t letters = 0;
+            for (int i = 0; i < 32; i++) {
+                const uint64_t word = i < 16 ? high : low;
+                letters = letters << 1 | ((word >> (60 - 4 * (i % 16)) & 0xF) >= 10 ? 1u : 0u);
+            }
+            return letters;
+        }
+
+        public:
+        Uuid() = default;
+        Uuid(uint64_t high, uint64_t low) : high(high), low(low) {}
+
+        uint64_t get_high() const { return high; }
+        uint64_t get_low() const { return low; }
+        bool is_nil() const { return high == 0 && low == 0; }
+
+        /**
+         * Whether the id formats in lower or in upper case; an id with no letter digits is
+         * both, and one in mixed case neither.
+         */
+        bool is_lower_case() const { return upper == 0; }
+        bool is_upper_case() const { return upper == letter_digits(); }
+
+        /**
+         * The same id, formatting in lower or in upper case.
+         */
+        Uuid to_lower_case() const { return Uuid(high, low); }
+        Uuid to_upper_case() const {
+            Uuid x(high, low);
+            x.upper = letter_digits();
+            return x;
+        }
+
+        static Uuid from_bytes(const uint8_t * bytes) {
+            uint64_t high = 0, low = 0;
+            for (int i = 0; i < 8; i++) high = high << 8 | bytes[i];
+            for (int i = 8; i < 16; i++) low = low << 8 | bytes[i];
+            return Uuid(high, low);
+        }
+
+        void to_bytes(uint8_t * out) const {
+            for (int i = 0; i < 8; i++) out[i] = static_cast<uint8_t>(high >> (56 - 8 * i));
+            for (int i = 0; i < 8; i++) out[8 + i] = static_cast<uint8_t>(low >> (56 - 8 * i));
+        }
+
+        /**
+         * Parses the 36-character form xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx. Returns false, and
+         * leaves value unchanged, if text does not match the UUID pattern.
+         */
+        static bool parse(boost::string_view text, Uuid & value) {
+            if (text.size() != 36 || text[8] != '-' || text[13] != '-' || text[18] != '-' || text[23] != '-') return false;
+            const char * p = text.data();
+            uint64_t high = 0, low = 0;
+            uint32_t upper = 0;
+            if (!parse_hex(p, 4, high, upper) || !parse_hex(p + 9, 2, high, upper) || !parse_hex(p + 14, 2, high, upper)) return false;
+            if (!parse_hex(p + 19, 2, low, upper) || !parse_hex(p + 24, 6, low, upper)) return false;
+            value = Uuid(high, low);
+            value.upper = upper;
+            return true;
+        }
+
+        /**
+         * Writes the 36-character form to out, in the case each digit was parsed in.
+         */
+        void format(char * out) const {
+            static const char digits[2][17] = { "0123456789abcdef", "0123456789ABCDEF" };
+            static const uint8_t offsets[16] = { 0, 2, 4, 6, 9, 11, 14, 16, 19, 21, 24, 26, 28, 30, 32, 34 };
+            uint8_t bytes[16];
+            to_bytes(bytes);
+            out[8] = out[13] = out[18] = out[23] = '-';
+            for (int i = 0; i < 16; i++) {
+                out[offsets[i]] = digits[upper >> (31 - 2 * i) & 1][bytes[i] >> 4];
+                out[offsets[i] + 1] = digits[upper >> (30 - 2 * i) & 1][bytes[i] & 0xF];
+            }
+        }
+
+        std::string to_string() const {
+            std::string text(36, '\0');
+            format(&text[0]);
+            return text;
+        }
+
+        size_t hash() const {
+            uint64_t h = high ^ (low * 0x9E3779B97F4A7C15u);
+            h ^= h >> 32;
+            h *= 0xD6E8FEB86659FD93u;
+            h ^= h >> 32;
+            return static_cast<size_t>(h);
+        }
+
+        friend bool operator==(const Uuid & a, const Uuid & b) { return a.high == b.high && a.low == b.low; }
+        friend bool operator!=(const Uuid & a, const Uuid & b) { return !(a == b); }
+        friend bool operator<(const Uuid & a, const Uuid & b) { return a.high < b.high || (a.high == b.high && a.low < b.low); }
+        friend bool operator>(const Uuid & a, const Uuid & b) { return b < a; }
+        friend bool operator<=(const Uuid & a, const Uuid & b) { return !(b < a); }
+        friend bool operator>=(const Uuid & a, const Uuid & b) { return !(a < b); }
+
+        /**
+         * A fresh random (version 4) UUID from this thread's UuidGenerator.
+         */
+        static Uuid generate();
+    };
+
+    /**
+     * Random (version 4) UUIDs from a xoshiro256** generator seeded from std::random_device.
+     * Each thread gets its own through Uuid::generate, so generating takes no lock. It is not
+     * a cryptographic generator; ids are unique, not unguessable. A process forked from a
+     * thread that has used Uuid::generate continues that thread's sequence, so reseed() in
+     * the child.
+     */
+    class UuidGenerator {
+        private:
+        uint64_t state[4];
+
+        static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+        static uint64_t splitmix(uint64_t & seed) {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15u);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+            return z ^ (z >> 31);
+        }
+
+        uint64_t next_word() {
+            const uint64_t result = rotl(state[1] * 5, 7) * 9;
+            const uint64_t t = state[1] << 17;
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = rotl(state[3], 45);
+            return result;
+        }
+
+        public:
+        UuidGenerator() { reseed(); }
+        explicit UuidGenerator(uint64_t seed) { reseed(seed); }
+
+        void reseed() {
+            std::random_device device;
+            uint64_t seed = static_cast<uint64_t>(device()) << 32 | device();
+            seed ^= static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+            reseed(seed);
+        }
+
+        void reseed(uint64_t seed) {
+            for (uint64_t & word : state) word = splitmix(seed);
+        }
+
+        Uuid next() {
+            const uint64_t high = next_word();
+            const uint64_t low = next_word();
+            return Uuid((high & ~uint64_t(0xF000)) | 0x4000, (low & ~(uint64_t(3) << 62)) | uint64_t(2) << 62);
+        }
+    };
+
+    inline Uuid Uuid::generate() {
+        static thread_local UuidGenerator generator;
+        return generator.next();
+    }
+
+    inline void to_json(json & j, const Uuid & x) {
+        j = x.to_string();
+    }
+
+    inline void from_json(const json & j, Uuid & x) {
+        if (!j.is_string() || !Uuid::parse(j.get_ref<const std::string &>(), x)) throw JsonDecodeException("Value doesn't match the UUID pattern");
+    }
+
+    inline void read_json(JsonReader & r, Uuid & x) {
+        boost::string_view text;
+        r.read(text);
+        if (r.ok() && !Uuid::parse(text, x)) r.fail(DecodeErrorKind::CONSTRAINT_VIOLATION, "Value doesn't match the UUID pattern (" + text.to_string() + ")");
+    }
+
+    inline void write_json(JsonWriter & w, const Uuid & x) {
+        char text[36];
+        x.format(text);
+        w.write_string(boost::string_view(text, sizeof(text)));
+    }
+
+    /**
+     * Packed form: marker 1 and the 16 bytes of a lower-case id, marker 2 and the bytes of an
+     * upper-case id, or marker 0 and the text of an id in mixed case.
+     */
+    inline void write_packed(PackedWriter & w, const Uuid & x) {
+        if (!x.is_lower_case() && !x.is_upper_case()) {
+            char text[36];
+            x.format(text);
+            w.write_u8(0);
+            w.write_string(boost::string_view(text, sizeof(text)));
+            return;
+        }
+        uint8_t bytes[16];
+        x.to_bytes(bytes);
+        w.write_u8(x.is_lower_case() ? 1 : 2);
+        w.write_bytes(bytes, sizeof(bytes));
+    }
+
+    inline void read_packed(PackedReader & r, Uuid & x) {
+        const uint8_t * bytes = nullptr;
+        boost::string_view text;
+        const uint8_t form = r.read_uuid(bytes, text);
+        if (!r.ok()) return;
+        if (form == 1) x = Uuid::from_bytes(bytes);
+        else if (form == 2) x = Uuid::from_bytes(bytes).to_upper_case();
+        else if (!Uuid::parse(text, x)) r.fail(DecodeErrorKind::CONSTRAINT_VIOLATION, "Value doesn't match the UUID pattern (" + text.to_string() + ")");
+    }
+}
+
+namespace std {
+    template <>
+    struct hash<quicktype::Uuid> {
+        size_t operator()(const quicktype::Uuid & x) const { return x.hash(); }
+    };
+}
+#endif
+
+#ifndef QUICKTYPE_INSTANT_HELPER
+#define QUICKTYPE_INSTANT_HELPER
+namespace quicktype {
+    class InstantFormatter;
+
+    /**
+     * A point in time held as nanoseconds since 1970-01-01T00:00:00Z, for the time stamp
+     * members, which the schemas allow either as numeric seconds or as an RFC 3339 date-time.
+     * An instant remembers which of the two forms it was read from and is written back in that
+     * form. A date-time also keeps its UTC offset, including -00:00, and its number of
+     * fractional digits, so it is written back as received, except that a t, z or space
+     * separator is written as T or Z, digits past the nanosecond are dropped and a leap second
+     * becomes the first second of the next minute. The range is that of int64_t nanoseconds,
+     * roughly the years 1678 to 2262; other strings, like date-times out of that range or
+     * without an offset, are kept verbatim (see from_string). Comparisons look at the point in
+     * time, then at verbatim text.
+     */
+    class Instant {
+        friend class InstantFormatter;
+
+        private:
+        int64_t nanoseconds = 0;
+        bool text = false;
+        // fractional digits of the date-time, or -1 for 3, 6 or 9 as needed
+        int8_t fraction_digits = -1;
+        // minutes east of UTC of the date-time, or utc to write it with a Z
+        int16_t offset = utc;
+        // the string the instant was read from if it cannot write it back, or null
+        std::shared_ptr<const std::string> verbatim;
+
+        static const int64_t nanoseconds_per_second = 1000000000;
+        static const int64_t max_seconds = 9223372035;
+
+        static int64_t floor_div(int64_t a, int64_t b) { return a / b - (a % b < 0 ? 1 : 0); }
+
+        static int offset_minutes(int offset) { return offset == utc || offset == unknown_offset ? 0 : offset; }
+
+        static bool read_digits(const char * p, int count, unsigned & value) {
+            value = 0;
+            for (int i = 0; i < count; i++) {
+                const unsigned digit = static_cast<unsigned>(p[i] - '0');
+                if (digit > 9) return false;
+                value = value * 10 + digit;
+            }
+            return true;
+        }
+
+        static void write_digits(char * p, int count, unsigned value) {
+            for (int i = count - 1; i >= 0; i--) {
+                p[i] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            }
+        }
+
+        static unsigned days_in_month(unsigned year, unsigned month) {
+            static const unsigned days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+            const bool leap = year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+            return month == 2 && leap ? 29 : days[month - 1];
+        }
+
+        /**
+         * Days from 1970-01-01 to the given proleptic Gregorian date, and back.
+         */
+        static int64_t days_from_civil(int64_t year, unsigned month, unsigned day) {
+            year -= month <= 2;
+            const int64_t era = floor_div(year, 400);
+            const unsigned yoe = static_cast<unsigned>(year - era * 400);
+            const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+            const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+            return era * 146097 + static_cast<int64_t>(doe) - 719468;
+        }
+
+        static void civil_from_days(int64_t days, int64_t & year, unsigned & month, unsigned & day) {
+            days += 719468;
+            const int64_t era = floor_div(days, 146097);
+            const unsigned doe = static_cast<unsigned>(days - era * 146097);
+            const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+            const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+            const unsigned mp = (5 * doy + 2) / 153;
+            day = doy - (153 * mp + 2) / 5 + 1;
+            month = mp < 10 ? mp + 3 : mp - 9;
+            year = static_cast<int64_t>(yoe) + era * 400 + (month <= 2);
+        }
+
+        /**
+         * Writes YYYY-MM-DDTHH:MM:SS of the given seconds since the epoch to out (19
+         * characters).
+         */
+        static void write_date_time(char * out, int64_t seconds) {
+            const int64_t days = floor_div(seconds, 86400);
+            const unsigned time = static_cast<unsigned>(seconds - days * 86400);
+            int64_t year;
+            unsigned month, day;
+            civil_from_days(days, year, month, day);
+
+            write_digits(out, 4, static_cast<unsigned>(year));
+            out[4] = '-';
+            write_digits(out + 5, 2, month);
+            out[7] = '-';
+            write_digits(out + 8, 2, day);
+            out[10] = 'T';
+            write_digits(out + 11, 2, time / 3600);
+            out[13] = ':';
+            write_digits(out + 14, 2, time / 60 % 60);
+            out[16] = ':';
+            write_digits(out + 17, 2, time % 60);
+        }
+
+        /**
+         * Writes the fraction of a second with the given number of digits, or with 3, 6 or 9
+         * as needed for -1, and the offset or Z to out, and returns their length.
+         */
+        static size_t write_fraction_and_offset(char * out, unsigned fraction, int digits, int offset) {
+            size_t length = 0;
+            if (digits < 0 && fraction != 0) digits = fraction % 1000000 == 0 ? 3 : fraction % 1000 == 0 ? 6 : 9;
+            if (digits > 0) {
+                unsigned value = fraction;
+                for (int i = digits; i < 9; i++) value /= 10;
+                out[length++] = '.';
+                write_digits(out + length, digits, value);
+                length += static_cast<size_t>(digits);
+            }
+            if (offset == utc) {
+                out[length++] = 'Z';
+                return length;
+            }
+            out[length] = offset < 0 ? '-' : '+';
+            const int signed_minutes = offset_minutes(offset);
+            const unsigned minutes = static_cast<unsigned>(signed_minutes < 0 ? -signed_minutes : signed_minutes);
+            write_digits(out + length + 1, 2, minutes / 60);
+            out[length + 3] = ':';
+            write_digits(out + length + 4, 2, minutes % 60);
+            return length + 6;
+        }
+
+        int64_t local_seconds(int64_t seconds) const { return seconds + offset_minutes(offset) * 60; }
+
+        /**
+         * Reads the fields of YYYY-MM-DDTHH:MM:SS with optional fractional seconds and an
+         * optional Z or +HH:MM offset: the seconds since the epoch in UTC, or in local time if
+         * there is no offset, the fraction in nanoseconds, the number of fractional digits and
+         * the offset.
+         */
+        static bool read_date_time(boost::string_view text, int64_t & seconds, int64_t & fraction, ptrdiff_t & digit_count, int & offset, bool & has_offset) {
+            if (text.size() < 19) return false;
+            const char * p = text.data();
+            const char * const end = p + text.size();
+            unsigned year, month, day, hour, minute, second;
+            if (!read_digits(p, 4, year) || p[4] != '-' || !read_digits(p + 5, 2, month) || p[7] != '-' || !read_digits(p + 8, 2, day)) return false;
+            if (p[10] != 'T' && p[10] != 't' && p[10] != ' ') return false;
+            if (!read_digits(p + 11, 2, hour) || p[13] != ':' || !read_digits(p + 14, 2, minute) || p[16] != ':' || !read_digits(p + 17, 2, second)) return false;
+            if (month < 1 || month > 12 || day < 1 || day > days_in_month(year, month) || hour > 23 || minute > 59 || second > 60) return false;
+            p += 19;
+
+            fraction = 0;
+            digit_count = 0;
+            if (p < end && *p == '.') {
+                const char * const digits = ++p;
+                for (; p < end && static_cast<unsigned>(*p - '0') <= 9; p++) {
+                    if (p - digits < 9) fraction = fraction * 10 + (*p - '0');
+                }
+                digit_count = p - digits;
+                if (digit_count == 0) return false;
+                for (ptrdiff_t i = digit_count; i < 9; i++) fraction *= 10;
+            }
+
+            offset = utc;
+            has_offset = p != end;
+            if (!has_offset || (end - p == 1 && (*p == 'Z' || *p == 'z'))) {
+                offset = utc;
+            } else if (end - p == 6 && (*p == '+' || *p == '-')) {
+                unsigned offset_hour, offset_minute;
+                if (!read_digits(p + 1, 2, offset_hour) || p[3] != ':' || !read_digits(p + 4, 2, offset_minute) || offset_hour > 23 || offset_minute > 59) return false;
+                offset = static_cast<int>(offset_hour * 60 + offset_minute);
+                if (*p == '-') offset = offset == 0 ? unknown_offset : -offset;
+            } else {
+                return false;
+            }
+
+            seconds = days_from_civil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second - offset_minutes(offset) * 60;
+            return true;
+        }
+
+        static int compare(const Instant & a, const Instant & b) {
+            if (a.nanoseconds != b.nanoseconds) return a.nanoseconds < b.nanoseconds ? -1 : 1;
+            if (!a.verbatim || !b.verbatim) return (a.verbatim ? 1 : 0) - (b.verbatim ? 1 : 0);
+            return a.verbatim->compare(*b.verbatim);
+        }
+
+        public:
+        /**
+         * Longest text written by format: YYYY-MM-DDTHH:MM:SS.fffffffff+HH:MM.
+         */
+        static const size_t max_text_length = 35;
+
+        /**
+         * The offset of date-times written with a Z.
+         */
+        static const int16_t utc = INT16_MIN;
+
+        /**
+         * The offset of date-times written with -00:00, UTC with the local offset unknown
+         * (RFC 3339, section 4.3).
+         */
+        static const int16_t unknown_offset = INT16_MIN + 1;
+
+        Instant() = default;
+        explicit Instant(int64_t nanoseconds, bool text = false) : nanoseconds(nanoseconds), text(text) {}
+
+        /**
+         * The current time from std::chrono::system_clock.
+         */
+        static Instant now(bool text = false) {
+            const auto since_epoch = std::chrono::system_clock::now().time_since_epoch();
+            return Instant(std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count(), text);
+        }
+
+        int64_t get_nanoseconds() const { return nanoseconds; }
+
+        /**
+         * The instant as seconds since the epoch. from_seconds gives back the same instant if
+         * it falls on a whole microsecond, and the nearest one the double can hold otherwise.
+         */
+        double get_seconds() const {
+            const int64_t seconds = floor_div(nanoseconds, nanoseconds_per_second);
+            return static_cast<double>(seconds) + static_cast<double>(nanoseconds - seconds * nanoseconds_per_second) / 1e9;
+        }
+
+        /**
+         * Whether the instant is written as an RFC 3339 date-time rather than numeric seconds.
+         */
+        bool is_text() const { return text; }
+        void set_text(bool value) { text = value; }
+
+        /**
+         * The offset from UTC, in minutes between -1439 and 1439, that the date-time is
+         * written in, utc to write it in UTC with a Z, the default, or unknown_offset to write
+         * it in UTC with -00:00.
+         */
+        int get_offset() const { return offset; }
+        void set_offset(int minutes) { offset = static_cast<int16_t>(minutes); }
+
+        /**
+         * The number of fractional digits, 0 to 9, that the date-time is written with, or -1,
+         * the default, for 3, 6 or 9 as needed to write the instant exactly. Digits past the
+         * given number are truncated.
+         */
+        int get_fraction_digits() const { return fraction_digits; }
+        void set_fraction_digits(int digits) { fraction_digits = static_cast<int8_t>(digits); }
+
+        /**
+         * The string the instant was read from if it is not a date-time the instant can write
+         * back, or null; see from_string. It is written in place of the instant.
+         */
+        const std::string * get_verbatim() const { return verbatim.get(); }
+
+        /**
+         * Reads numeric seconds since the epoch. A double only holds a time stamp of today to
+         * about a quarter of a microsecond, so the whole millisecond or microsecond that reads
+         * as the same double is taken if there is one, and seconds rounded to the nanosecond
+         * otherwise. Returns false, and leaves value unchanged, if seconds is not finite or out
+         * of range.
+         */
+        static bool from_seconds(double seconds, Instant & value) {
+            if (!(seconds >= -static_cast<double>(max_seconds) && seconds <= static_cast<double>(max_seconds))) return false;
+            const double whole = std::floor(seconds);
+            const int64_t nanoseconds = static_cast<int64_t>(whole) * nanoseconds_per_second + std::llround((seconds - whole) * 1e9);
+            for (const int64_t unit : { INT64_C(1000000), INT64_C(1000) }) {
+                const Instant rounded(floor_div(nanoseconds + unit / 2, unit) * unit, false);
+                if (rounded.get_seconds() == seconds) {
+                    value = rounded;
+                    return true;
+                }
+            }
+            value = Instant(nanoseconds, false);
+            return true;
+        }
+
+        /**
+         * Parses an RFC 3339 date-time, YYYY-MM-DDTHH:MM:SS with optional fractional seconds
+         * and a Z or +HH:MM offset, keeping the offset and the number of fractional digits.
+         * Digits past the nanosecond are dropped. Returns false, and leaves value unchanged, if
+         * text is not a valid date-time or is out of range.
+         */
+        static bool parse(boost::string_view text, Instant & value) {
+            int64_t seconds, fraction;
+            ptrdiff_t digit_count;
+            int offset;
+            bool has_offset;
+            if (!read_date_time(text, seconds, fraction, digit_count, offset, has_offset) || !has_offset) return false;
+            if (seconds < -max_seconds || seconds > max_seconds) return false;
+            value = Instant(seconds * nanoseconds_per_second + fraction, true);
+            value.fraction_digits = static_cast<int8_t>(digit_count < 9 ? digit_count : 9);
+            value.offset = static_cast<int16_t>(offset);
+            return true;
+        }
+
+        /**
+         * The instant of a time stamp string, which the schemas do not restrict. Text parse
+         * accepts is read as a date-time. Any other string is kept verbatim and written back
+         * unchanged; the instant is then the time it names as near as the range allows, with
+         * a date-time without an offset read as UTC, or the epoch if it is not a date-time.
+         */
+        static Instant from_string(boost::string_view text) {
+            Instant value;
+            if (parse(text, value)) return value;
+            int64_t seconds, fraction;
+            ptrdiff_t digit_count;
+            int offset;
+            bool has_offset;
+            value = Instant(0, true);
+            if (read_date_time(text, seconds, fraction, digit_count, offset, has_offset)) {
+                if (seconds < -max_seconds || seconds > max_seconds) {
+                    seconds = seconds < 0 ? -max_seconds : max_seconds;
+                    fraction = 0;
+                }
+                value.nanoseconds = seconds * nanoseconds_per_second + fraction;
+                value.fraction_digits = static_cast<int8_t>(digit_count < 9 ? digit_count : 9);
+                value.offset = static_cast<int16_t>(offset);
+            }
+            value.verbatim = std::make_shared<const std::string>(text.data(), text.size());
+            return value;
+        }
+
+        /**
+         * Writes the instant as an RFC 3339 date-time to out, in its offset and with its number
+         * of fractional digits, and returns its length, at most max_text_length. Verbatim text
+         * is not written; to_string returns it.
+         */
+        size_t format(char * out) const {
+            const int64_t seconds = floor_div(nanoseconds, nanoseconds_per_second);
+            const unsigned fraction = static_cast<unsigned>(nanoseconds - seconds * nanoseconds_per_second);
+            write_date_time(out, local_seconds(seconds));
+            return 19 + write_fraction_and_offset(out + 19, fraction, fraction_digits, offset);
+        }
+
+        std::string to_string() const {
+            if (verbatim) return *verbatim;
+            char buffer[max_text_length];
+            return std::string(buffer, format(buffer));
+        }
+
+        friend bool operator==(const Instant & a, const Instant & b) { return compare(a, b) == 0; }
+        friend bool operator!=(const Instant & a, const Instant & b) { return compare(a, b) != 0; }
+        friend bool operator<(const Instant & a, const Instant & b) { return compare(a, b) < 0; }
+        friend bool operator>(const Instant & a, const Instant & b) { return compare(a, b) > 0; }
+        friend bool operator<=(const Instant & a, const Instant & b) { return compare(a, b) <= 0; }
+        friend bool operator>=(const Instant & a, const Instant & b) { return compare(a, b) >= 0; }
+    };
+
+    /**
+     * Formats instants as Instant::format does, for publishers that stamp many messages a
+     * second. The YYYY-MM-DDTHH:MM: prefix is rendered once per minute and reused, so each
+     * call only writes the seconds, the fraction and the offset. Not thread-safe; use one per
+     * thread.
+     */
+    class InstantFormatter {
+        private:
+        int64_t minute = INT64_MIN;
+        char prefix[19] = {};
+
+        public:
+        size_t format(const Instant & x, char * out) {
+            const int64_t utc_seconds = Instant::floor_div(x.nanoseconds, Instant::nanoseconds_per_second);
+            const unsigned fraction = static_cast<unsigned>(x.nanoseconds - utc_seconds * Instant::nanoseconds_per_second);
+            const int64_t seconds = x.local_seconds(utc_seconds);
+            if (seconds < minute || seconds >= minute + 60) {
+                minute = Instant::floor_div(seconds, 60) * 60;
+                Instant::write_date_time(prefix, minute);
+            }
+            std::memcpy(out, prefix, 17);
+            Instant::write_digits(out + 17, 2, static_cast<unsigned>(seconds - minute));
+            return 19 + Instant::write_fraction_and_offset(out + 19, fraction, x.fraction_digits, x.offset);
+        }
+
+        std::string to_string(const Instant & x) {
+            char buffer[Instant::max_text_length];
+            return std::string(buffer, format(x, buffer));
+        }
+    };
+
+    inline void to_json(json & j, const Instant & x) {
+        if (x.is_text()) j = x.to_string();
+        else j = x.get_seconds();
+    }
+
+    inline void from_json(const json & j, Instant & x) {
+        if (j.is_number()) {
+            if (!Instant::from_seconds(j.get<double>(), x)) throw JsonDecodeException("Time stamp out of range");
+        } else if (j.is_string()) {
+            x = Instant::from_string(j.get_ref<const std::string &>());
+        } else {
+            throw JsonDecodeException("Could not deserialize");
+        }
+    }
+
+    inline void read_json(JsonReader & r, Instant & x) {
+        switch (r.peek()) {
+            case JsonToken::NUMBER: {
+                double value = 0;
+                r.read(value);
+                if (r.ok() && !Instant::from_seconds(value, x)) r.fail(DecodeErrorKind::CONSTRAINT_VIOLATION, "Time stamp out of range");
+                break;
+            }
+            case JsonToken::STRING: {
+                boost::string_view value;
+                r.read(value);
+                if (r.ok()) x = Instant::from_string(value);
+                break;
+            }
+            default: r.fail(DecodeErrorKind::TYPE_MISMATCH, "Could not deserialize");
+        }
+    }
+
+    inline void write_json(JsonWriter & w, const Instant & x) {
+        if (x.get_verbatim()) {
+            w.write_string(*x.get_verbatim());
+        } else if (x.is_text()) {
+            static thread_local InstantFormatter formatter;
+            char text[Instant::max_text_length];
+            w.write_string(boost::string_view(text, formatter.format(x, text)));
+        } else {
+            w.write_double(x.get_seconds());
+        }
+    }
+
+    /**
+     * Packed form: marker 2 (numeric seconds) or 3 (date-time in UTC with 3, 6 or 9 fractional
+     * digits as needed) and the nanoseconds as a zigzag varint. Other date-times are marker 4,
+     * the nanoseconds, the offset as a zigzag varint and the number of fractional digits plus
+     * one as a byte. Verbatim text is marker 1 and the string. Marker 0 (seconds as a double)
+     * is read as well.
+     */
+    inline void write_packed(PackedWriter & w, const Instant & x) {
+        if (x.get_verbatim()) {
+            w.write_u8(1);
+            w.write_string(*x.get_verbatim());
+            return;
+        }
+        const bool plain = !x.is_text() || (x.get_offset() == Instant::utc && x.get_fraction_digits() < 0);
+        w.write_u8(plain ? (x.is_text() ? 3 : 2) : 4);
+        w.write_integer(x.get_nanoseconds());
+        if (plain) return;
+        w.write_integer(x.get_offset());
+        w.write_u8(static_cast<uint8_t>(x.get_fraction_digits() + 1));
+    }
+
+    inline void read_packed(PackedReader & r, Instant & x) {
+        const uint8_t marker = r.read_u8();
+        if (!r.ok()) return;
+        switch (marker) {
+            case 0: {
+                double value = 0;
+                r.read(value);
+                if (r.ok() && !Instant::from_seconds(value, x)) r.fail(DecodeErrorKind::CONSTRAINT_VIOLATION, "Time stamp out of range");
+                break;
+            }
+            case 1: {
+                boost::string_view value;
+                r.read(value);
+                if (r.ok()) x = Instant::from_string(value);
+                break;
+            }
+            case 2:
+            case 3: {
+                int64_t value = 0;
+                r.read(value);
+                x = Instant(value, marker == 3);
+                break;
+            }
+            case 4: {
+                int64_t value = 0, offset = 0;
+                r.read(value);
+                r.read(offset);
+                const uint8_t digits = r.read_u8();
+                if (!r.ok()) break;
+                if ((offset != Instant::utc && offset != Instant::unknown_offset && (offset < -1439 || offset > 1439)) || digits > 10) {
+                    r.fail(DecodeErrorKind::SYNTAX_ERROR, "invalid date-time form");
+                    break;
+                }
+                x = Instant(value, true);
+                x.set_offset(static_cast<int>(offset));
+                x.set_fraction_digits(digits - 1);
+                break;
+            }
+            default: r.fail(DecodeErrorKind::TYPE_MISMATCH, "Could not deserialize");
+        }
+    }
+}
+#endif
+
+#ifndef QUICKTYPE_CONSTRAINT_HELPER
+#define QUICKTYPE_CONSTRAINT_HELPER
+namespace quicktype {
+    /**
+     * A string pattern of a ClassMemberConstraints, compiled once per distinct pattern.
+     *
+     * Anchored patterns that only consist of literals and fixed-width character classes (this
+     * covers the UUID and hh:mm:ss patterns used by the schemas) are compiled into a
+     * per-position character table and matched in linear time. Everything else falls back to a
+     * std::regex that is built once and shared by all constraints using the same pattern.
+     */
+    class ClassMemberPattern {
+        private:
+        std::vector<std::bitset<256>> positions;
+        bool fixed_width;
+        std::regex regex;
+
+        static bool compile_fixed_width(const std::string & pattern, std::vector<std::bitset<256>> & positions) {
+            if (pattern.length() < 2 || pattern.front() != '^' || pattern.back() != '$') return false;
+            const size_t end = pattern.length() - 1;
+            size_t i = 1;
+            while (i < end) {
+                std::bitset<256> chars;
+                const char c = pattern[i];
+                if (c == '[') {
+                    const size_t close = pattern.find(']', i + 1);
+                    if (close == std::string::npos || close >= end || close == i + 1) return false;
+                    for (size_t k = i + 1; k < close; k++) {
+                        const unsigned char lo = static_cast<unsigned char>(pattern[k]);
+                        if (lo == '\\' || lo == '^' || lo == '[') return false;
+                        if (k + 2 < close && pattern[k + 1] == '-') {
+                            const unsigned char hi = static_cast<unsigned char>(pattern[k + 2]);
+                            if (hi < lo) return false;
+                            for (unsigned int ch = lo; ch <= hi; ch++) chars.set(ch);
+                            k += 2;
+                        } else {
+                            chars.set(lo);
+                        }
+                    }
+                    i = close + 1;
+                } else if (c == '\0' || std::string("\\.()|*+?{}[]^$").find(c) != std::string::npos) {
+                    return false;
+                } else {
+                    chars.set(static_cast<unsigned char>(c));
+                    i++;
+                }
+
+                size_t count = 1;
+                if (i < end && pattern[i] == '{') {
+                    const size_t close = pattern.find('}', i + 1);
+                    if (close == std::string::npos || close >= end || close == i + 1 || close - i > 5) return false;
+                    count = 0;
+                    for (size_t k = i + 1; k < close; k++) {
+                        if (pattern[k] < '0' || pattern[k] > '9') return false;
+                        count = count * 10 + static_cast<size_t>(pattern[k] - '0');
+                    }
+                    i = close + 1;
+                }
+                positions.insert(positions.end(), count, chars);
+            }
+            return true;
+        }
+
+        public:
+        ClassMemberPattern(const std::string & pattern) : fixed_width(compile_fixed_width(pattern, positions)) {
+            if (!fixed_width) {
+                positions.clear();
+                regex = std::regex(pattern);
+            }
+        }
+        ClassMemberPattern(const ClassMemberPattern &) = delete;
+        ClassMemberPattern & operator=(const ClassMemberPattern &) = delete;
+
+        bool is_fixed_width() const { return fixed_width; }
+
+        /**
+         * Sets out to a random string that matches a fixed-width pattern, drawing from
+         * random. Returns false for patterns that fall back to std::regex.
+         */
+        template <typename Random>
+        bool sample(Random & random, std::string & out) const {
+            if (!fixed_width) return false;
+            out.resize(positions.size());
+            for (size_t i = 0; i < positions.size(); i++) {
+                const std::bitset<256> & chars = positions[i];
+                size_t pick = static_cast<size_t>(random() % chars.count());
+                unsigned int ch = 0;
+                while (!chars[ch] || pick-- != 0) ch++;
+                out[i] = static_cast<char>(ch);
+            }
+            return true;
+        }
+
+        bool matches(const std::string & value) const {
+            if (!fixed_width) return std::regex_search(value, regex);
+            if (value.length() != positions.size()) return false;
+            for (size_t i = 0; i < positions.size(); i++) {
+                if (!positions[i][static_cast<unsigned char>(value[i])]) return false;
+            }
+            return true;
+        }
+
+        /**
+         * Returns the compiled form of pattern. Compiled patterns live for the whole program.
+         */
+        static const ClassMemberPattern & get(const std::string & pattern) {
+            static std::mutex mutex;
+            static std::map<std::string, std::unique_ptr<ClassMemberPattern>> compiled;
+            std::lock_guard<std::mutex> lock(mutex);
+            std::unique_ptr<ClassMemberPattern> & p = compiled[pattern];
+            if (!p) p.reset(new ClassMemberPattern(pattern));
+            return *p;
+        }
+    };
+
+    class ClassMemberConstraints {
+        private:
+        boost::optional<int> min_value;
+        boost::optional<int> max_value;
+        boost::optional<size_t> min_length;
+        boost::optional<size_t> max_length;
+        boost::optional<std::string> pattern;
+        const ClassMemberPattern * pattern_matcher = nullptr;
+
+        public:
+        ClassMemberConstraints(
+            boost::optional<int> min_value,
+            boost::optional<int> max_value,
+            boost::optional<size_t> min_length,
+            boost::optional<size_t> max_length,
+            boost::optional<std::string> pattern
+        ) : min_value(min_value), max_value(max_value), min_length(min_length), max_length(max_length), pattern(pattern),
+            pattern_matcher(pattern != boost::none ? &ClassMemberPattern::get(*pattern) : nullptr) {}
+        ClassMemberConstraints() = default;
+        ClassMemberConstraints(const ClassMemberConstraints &) = default;
+        ClassMemberConstraints(ClassMemberConstraints &&) = default;
+        ClassMemberConstraints & operator=(const ClassMemberConstraints &) = default;
+        ClassMemberConstraints & operator=(ClassMemberConstraints &&) = default;
+        virtual ~ClassMemberConstraints() = default;
+
+        void set_min_value(int min_value) { this->min_value = min_value; }
+        auto get_min_value() const { return min_value; }
+
+        void set_max_value(int max_value) { this->max_value = max_value; }
+        auto get_max_value() const { return max_value; }
+
+        void set_min_length(size_t min_length) { this->min_length = min_length; }
+        auto get_min_length() const { return min_length; }
+
+        void set_max_length(size_t max_length) { this->max_length = max_length; }
+        auto get_max_length() const { return max_length; }
+
+        void set_pattern(const std::string &  pattern) { this->pattern = pattern; this->pattern_matcher = &ClassMemberPattern::get(pattern); }
+        auto get_pattern() const { return pattern; }
+        const ClassMemberPattern * get_pattern_matcher() const { return pattern_matcher; }
+    };
+
+    class ClassMemberConstraintException : public std::runtime_error {
+        public:
+        ClassMemberConstraintException(const std::string &  msg) : std::runtime_error(msg) {}
+    };
+
+    class ValueTooLowException : public ClassMemberConstraintException {
+        public:
+        ValueTooLowException(const std::string &  msg) : ClassMemberConstraintException(msg) {}
+    };
+
+    class ValueTooHighException : public ClassMemberConstraintException {
+        public:
+        ValueTooHighException(const std::string &  msg) : ClassMemberConstraintException(msg) {}
+    };
+
+    class ValueTooShortException : public ClassMemberConstraintException {
+        public:
+        ValueTooShortException(const std::string &  msg) : ClassMemberConstraintException(msg) {}
+    };
+
+    class ValueTooLongException : public ClassMemberConstraintException {
+        public:
+        ValueTooLongException(const std::string &  msg) : ClassMemberConstraintException(msg) {}
+    };
+
+    class InvalidPatternException : public ClassMemberConstraintException {
+        public:
+        InvalidPatternException(const std::string &  msg) : ClassMemberConstraintException(msg) {}
+    };
+
+    inline void CheckConstraint(const std::string &  name, const ClassMemberConstraints & c, int64_t value) {
+        if (c.get_min_value() != boost::none && value < *c.get_min_value()) {
+            throw ValueTooLowException ("Value too low for " + name + " (" + std::to_string(value) + "<" + std::to_string(*c.get_min_value()) + ")");
+        }
+
+        if (c.get_max_value() != boost::none && value > *c.get_max_value()) {
+            throw ValueTooHighException ("Value too high for " + name + " (" + std::to_string(value) + ">" + std::to_string(*c.get_max_value()) + ")");
+        }
+    }
+
+    inline void CheckConstraint(const std::string &  name, const ClassMemberConstraints & c, const std::string &  value) {
+        if (c.get_min_length() != boost::none && value.length() < *c.get_min_length()) {
+            throw ValueTooShortException ("Value too short for " + name + " (" + std::to_string(value.length()) + "<" + std::to_string(*c.get_min_length()) + ")");
+        }
+
+        if (c.get_max_length() != boost::none && value.length() > *c.get_max_length()) {
+            throw ValueTooLongException ("Value too long for " + name + " (" + std::to_string(value.length()) + ">" + std::to_string(*c.get_max_length()) + ")");
+        }
+
+        if (c.get_pattern_matcher() != nullptr && !c.get_pattern_matcher()->matches(value)) {
+            throw InvalidPatternException ("Value doesn't match pattern for " + name + " (" + value +" != " + *c.get_pattern() + ")");
+        }
+    }
+
+    /**
+     * Non-throwing form of CheckConstraint for JsonReader and PackedReader: a violation is
+     * recorded as the reader's error instead.
+     */
+    template <typename Reader>
+    inline void CheckConstraint(Reader & r, const std::string &  name, const ClassMemberConstraints & c, const std::string &  value) {
+        if (c.get_min_length() != boost::none && value.length() < *c.get_min_length()) {
+            r.fail(DecodeErrorKind::CONSTRAINT_VIOLATION, "Value too short for " + name + " (" + std::to_string(value.length()) + "<" + std::to_string(*c.get_min_length()) + ")");
+        } else if (c.get_max_length() != boost::none && value.length() > *c.get_max_length()) {
+            r.fail(DecodeErrorKind::CONSTRAINT_VIOLATION, "Value too long for " + name + " (" + std::to_string(value.length()) + ">" + std::to_string(*c.get_max_length()) + ")");
+        } else if (c.get_pattern_matcher() != nullptr && !c.get_pattern_matcher()->matches(value)) {
+            r.fail(DecodeErrorKind::CONSTRAINT_VIOLATION, "Value doesn't match pattern for " + name + " (" + value +" != " + *c.get_pattern() + ")");
+        }
+    }
+}
+#endif
+
+#ifndef QUICKTYPE_UNTYPED_HELPER
+#define QUICKTYPE_UNTYPED_HELPER
+namespace quicktype {
+    using nlohmann::json;
+
+    inline json get_untyped(const json & j, const char * property) {
+        if (j.find(property) != j.end()) {
+            return j.at(property).get<json>();
+        }
+        return json();
+    }
+
+    inline json get_untyped(const json & j, std::string property) {
+        return get_untyped(j, property.data());
+    }
+}
+#endif
+
+#ifndef QUICKTYPE_BATCH_HELPER
+#define QUICKTYPE_BATCH_HELPER
+namespace quicktype {
+    /**
+     * A fixed number of worker threads that share out the items of one job at a time. The
+     * threads are started once and wait between jobs, so running a job costs no thread
+     * creation; the calling thread works on the job too. Jobs from several threads run one
+     * after the other.
+     */
+    class WorkerPool {
+        private:
+        std::vector<std::thread> threads;
+        std::mutex job_mutex;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        const std::function<void(size_t, size_t)> * job = nullptr;
+        size_t count = 0;
+        size_t chunk = 1;
+        std::atomic<size_t> next{0};
+        size_t generation = 0;
+        size_t busy = 0;
+        bool stopping = false;
+
+        void work() {
+            for (;;) {
+                const size_t first = next.fetch_add(chunk);
+                if (first >= count) return;
+                (*job)(first, std::min(first + chunk, count));
+            }
+        }
+
+        void loop() {
+            size_t seen = 0;
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;) {
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                lock.unlock();
+                work();
+                lock.lock();
+                if (--busy == 0) done.notify_one();
+            }
+        }
+
+        public:
+        /**
+         * A pool of threads - 1 workers besides the calling thread, by default one per core.
+         */
+        explicit WorkerPool(size_t threads = std::thread::hardware_concurrency()) {
+            for (size_t i = 1; i < threads; i++) this->threads.emplace_back([this] { loop(); });
+        }
+
+        WorkerPool(const WorkerPool &) = delete;
+        WorkerPool & operator=(const WorkerPool &) = delete;
+
+        ~WorkerPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (std::thread & thread : threads) thread.join();
+        }
+
+        /**
+         * The number of threads working on a job, the calling thread included.
+         */
+        size_t size() const { return threads.size() + 1; }
+
+        /**
+         * Calls job(first, last) on ranges of [0, count) of at most chunk items until all are
+         * done, from the workers and the calling thread, and returns once every call returned.
+         * job must not throw.
+         */
+        void run(size_t count, size_t chunk, const std::function<void(size_t, size_t)> & job) {
+            if (count == 0) return;
+            std::lock_guard<std::mutex> job_lock(job_mutex);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                this->job = &job;
+                this->count = count;
+                this->chunk = std::max<size_t>(chunk, 1);
+                next = 0;
+                busy = threads.size();
+                generation++;
+            }
+            wake.notify_all();
+            work();
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [this] { return busy == 0; });
+        }
+    };
+
+    /**
+     * A message of a batch that did not decode.
+     */
+    class BatchError {
+        private:
+        size_t index;
+        DecodeError error;
+
+        public:
+        BatchError(size_t index, DecodeError error) : index(index), error(std::move(error)) {}
+
+        size_t get_index() const { return index; }
+        const DecodeError & get_error() const { return error; }
+    };
+
+    /**
+     * Decodes messages[i] into out[i] for each message, spread over the threads of pool.
+     * messages is a random access container of std::string or boost::string_view; out is
+     * resized to its size, so decoding a batch of the same size again reuses the slots. The
+     * messages that do not decode are returned in input order, their slots left default
+     * constructed.
+     */
+    template <typename T, typename Messages>
+    inline std::vector<BatchError> decode_batch(const Messages & messages, std::vector<T> & out, WorkerPool & pool) {
+        const size_t count = messages.size();
+        out.resize(count);
+        std::vector<BatchError> errors;
+        std::mutex errors_mutex;
+        // several chunks per thread, so that threads that finish early take over work
+        const size_t chunk = std::max<size_t>(1, std::min<size_t>(64, count / (8 * pool.size())));
+        pool.run(count, chunk, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++) {
+                const boost::string_view text(messages[i]);
+                JsonReader r(text.data(), text.size());
+                read_json(r, out[i]);
+                r.finish();
+                if (r.ok()) continue;
+                out[i] = T();
+                std::lock_guard<std::mutex> lock(errors_mutex);
+                errors.emplace_back(i, r.get_error());
+            }
+        });
+        std::sort(errors.begin(), errors.end(), [](const BatchError & a, const BatchError & b) { return a.get_index() < b.get_index(); });
+        return errors;
+    }
+}
+#endif
+
+namespace quicktype {
+namespace elevator_status {
+    using nlohmann::json;
+
+    /**
+     * Metamodel identifier for a generic  messages. It actually points to this Schema.
+     */
+    enum class MsgMetamodel : int { ROPOD_MSG_SCHEMA_JSON };
+
+    constexpr boost::string_view enum_name(MsgMetamodel x) {
+        switch (x) {
+            case MsgMetamodel::ROPOD_MSG_SCHEMA_JSON: return boost::string_view("ropod-msg-schema.json", 21);
+        }
+        return boost::string_view();
+    }
+
+    inline bool enum_from_name(boost::string_view name, MsgMetamodel & x) {
+        MsgMetamodel value;
+        switch (hash_key(name.data(), name.size(), 0x6aa79987u) & 0u) {
+            case 0: value = MsgMetamodel::ROPOD_MSG_SCHEMA_JSON; break;
+            default: return false;
+        }
+        if (name != enum_name(value)) return false;
+        x = value;
+        return true;
+    }
+
+    using TimeStamp = optional<Instant>;
+
+    /**
+     * Id of receiver. Can be UUID or any string. This is optional.
+     *
+     * A time stamp using the date-time format. An RFC3339  Section 5.6 timestamp in UTC time.
+     * This is formatted as YYYY-MM-DDThh:mm:ss.fffZ. The milliseconds portion .fff is
+     * optional.
+     *
+     * Type identifier for the payload. This is usually an enum like type. E.g. CMD. More
+     * specific Schemata will further specify what will be required here.
+     *
+     * Version of message type. E.g. 0.1.0
+     *
+     * Metamodel identifier for the payload. This is usually a Schmea file like
+     * ropod-cmd-schema.json. More specific Schemata will further specify what will be required
+     * here.
+     */
+    enum class TypeEnum : int { ELEVATOR_STATUS, ELEVATOR_STATUS_QUERY };
+
+    constexpr boost::string_view enum_name(TypeEnum x) {
+        switch (x) {
+            case TypeEnum::ELEVATOR_STATUS: return boost::string_view("ELEVATOR-STATUS", 15);
+            case TypeEnum::ELEVATOR_STATUS_QUERY: return boost::string_view("ELEVATOR-STATUS-QUERY", 21);
+        }
+        return boost::string_view();
+    }
+
+    inline bool enum_from_name(boost::string_view name, TypeEnum & x) {
+        TypeEnum value;
+        switch (hash_key(name.data(), name.size(), 0x6aa79987u) & 1u) {
+            case 0: value = TypeEnum::ELEVATOR_STATUS; break;
+            case 1: value = TypeEnum::ELEVATOR_STATUS_QUERY; break;
+            default: return false;
+        }
+        if (name != enum_name(value)) return false;
+        x = value;
+        return true;
+    }
+
+    /**
+     * Complete specification of required and optioanl header parts.
+     *
+     * More spefific definition (than the definition of ropod-msg-schema.json). Only the type
+     * field is further specified.
+     */
+    class Header {
+        public:
+        Header() = default;
+        Header(const Header &) = default;
+        Header(Header &&) = default;
+        Header & operator=(const Header &) = default;
+        Header & operator=(Header &&) = default;
+        virtual ~Header() = default;
+
+        static const ClassMemberConstraints & get_msg_id_constraint() {
+            static const ClassMemberConstraints constraint(boost::none, boost::none, boost::none, boost::none, std::string("^[a-fA-F0-9]{8}-[a-fA-F0-9]{4}-[a-fA-F0-9]{4}-[a-fA-F0-9]{4}-[a-fA-F0-9]{12}$"));
+            return constraint;
+        }
+
+        private:
+        MsgMetamodel metamodel;
+        Uuid msg_id;
+        optional<std::vector<std::string>> receiver_ids;
+        TimeStamp timestamp;
+        TypeEnum type;
+        optional<std::string> version;
+
+        public:
+        const MsgMetamodel & get_metamodel() const { return metamodel; }
+        MsgMetamodel & get_mutable_metamodel() { return metamodel; }
+        void set_metamodel(const MsgMetamodel & value) { this->metamodel = value; }
+
+        const Uuid & get_msg_id() const { return msg_id; }
+        Uuid & get_mutable_msg_id() { return msg_id; }
+        void set_msg_id(const Uuid & value) { this->msg_id = value; }
+        std::string get_msg_id_string() const { return msg_id.to_string(); }
+        void set_msg_id(const std::string & value) { CheckConstraint("msg_id", get_msg_id_constraint(), value); Uuid::parse(value, this->msg_id); }
+
+        const optional<std::vector<std::string>> & get_receiver_ids() const { return receiver_ids; }
+        optional<std::vector<std::string>> & get_mutable_receiver_ids() { return receiver_ids; }
+        void set_receiver_ids(optional<std::vector<std::string>> value) { this->receiver_ids = std::move(value); }
+
+        const TimeStamp & get_timestamp() const { return timestamp; }
+        TimeStamp & get_mutable_timestamp() { return timestamp; }
+        void set_timestamp(TimeStamp value) { this->timestamp = std::move(value); }
+
+        const TypeEnum & get_type() const { return type; }
+        TypeEnum & get_mutable_type() { return type; }
+        void set_type(const TypeEnum & value) { this->type = value; }
+
+        const optional<std::string> & get_version() const { return version; }
+        optional<std::string> & get_mutable_version() { return version; }
+        void set_version(optional<std::string> value) { this->version = std::move(value); }
+    };
+
+    /**
+     * Id of receiver. Can be UUID or any string. This is optional.
+     *
+     * A time stamp using the date-time format. An RFC3339  Section 5.6 timestamp in UTC time.
+     * This is formatted as YYYY-MM-DDThh:mm:ss.fffZ. The milliseconds portion .fff is
+     * optional.
+     *
+     * Type identifier for the payload. This is usually an enum like type. E.g. CMD. More
+     * specific Schemata will further specify what will be required here.
+     *
+     * Version of message type. E.g. 0.1.0
+     *
+     * Metamodel identifier for the payload. This is usually a Schmea file like
+     * ropod-cmd-schema.json. More specific Schemata will further specify what will be required
+     * here.
+     *
+     * Metamodel elevator status message.
+     */
+    enum class MetamodelEnum : int { ROPOD_ELEVATOR_STATUS_SCHEMA_JSON };
+
+    constexpr boost::string_view enum_name(MetamodelEnum x) {
+        switch (x) {
+            case MetamodelEnum::ROPOD_ELEVATOR_STATUS_SCHEMA_JSON: return boost::string_view("ropod-elevator-status-schema.json", 33);
+        }
+        return boost::string_view();
+    }
+
+    inline bool enum_from_name(boost::string_view name, MetamodelEnum & x) {
+        MetamodelEnum value;
+        switch (hash_key(name.data(), name.size(), 0x6aa79987u) & 0u) {
+            case 0: value = MetamodelEnum::ROPOD_ELEVATOR_STATUS_SCHEMA_JSON; break;
+            default: return false;
+        }
+        if (name != enum_name(value)) return false;
+        x = value;
+        return true;
+    }
+
+    enum class Query : int { GET_ALL_ELEVATOR_IDS, GET_ELEVATOR_STATUS };
+
+    constexpr boost::string_view enum_name(Query x) {
+        switch (x) {
+            case Query::GET_ALL_ELEVATOR_IDS: return boost::string_view("GET_ALL_ELEVATOR_IDS", 20);
+            case Query::GET_ELEVATOR_STATUS: return boost::string_view("GET_ELEVATOR_STATUS", 19);
+        }
+        return boost::string_view();
+    }
+
+    inline bool enum_from_name(boost::string_view name, Query & x) {
+        Query value;
+        switch (hash_key(name.data(), name.size(), 0x6650bbfbu) & 3u) {
+            case 1: value = Query::GET_ALL_ELEVATOR_IDS; break;
+            case 3: value = Query::GET_ELEVATOR_STATUS; break;
+            default: return false;
+        }
+        if (name != enum_name(value)) return false;
+        x = value;
+        return true;
+    }
+
+    /**
+     * Status update for a single elevator.  This is a literal translation of the CAN bus
+     * protocol.
+     */
+    class ElevatorStatusPayload {
+        public:
+        ElevatorStatusPayload() = default;
+        ElevatorStatusPayload(const ElevatorStatusPayload &) = default;
+        ElevatorStatusPayload(ElevatorStatusPayload &&) = default;
+        ElevatorStatusPayload & operator=(const ElevatorStatusPayload &) = default;
+        ElevatorStatusPayload & operator=(ElevatorStatusPayload &&) = default;
+        virtual ~ElevatorStatusPayload() = default;
+
+        static const ClassMemberConstraints & get_query_id_constraint() {
+            static const ClassMemberConstraints constraint(boost::none, boost::none, boost::none, boost::none, std::string("^[a-fA-F0-9]{8}-[a-fA-F0-9]{4}-[a-fA-F0-9]{4}-[a-fA-F0-9]{4}-[a-fA-F0-9]{12}$"));
+            return constraint;
+        }
+
+        private:
+        MetamodelEnum metamodel;
+        optional<bool> admitted_request_from_robot;
+        optional<int64_t> calls;
+        optional<bool> door_open_at_goal_floor;
+        optional<bool> door_open_at_start_floor;
+        optional<bool> door_waits_for_closing_command;
+        optional<std::vector<int64_t>> elevator_ids;
+        optional<int64_t> floor;
+        optional<int64_t> id;
+        optional<bool> is_available;
+        optional<Uuid> query_id;
+        optional<bool> query_success;
+        optional<bool> status_has_changed;
+        optional<Query> query;
+
+        public:
+        const MetamodelEnum & get_metamodel() const { return metamodel; }
+        MetamodelEnum & get_mutable_metamodel() { return metamodel; }
+        void set_metamodel(const MetamodelEnum & value) { this->metamodel = value; }
+
+        const optional<bool> & get_admitted_request_from_robot() const { return admitted_request_from_robot; }
+        optional<bool> & get_mutable_admitted_request_from_robot() { return admitted_request_from_robot; }
+        void set_admitted_request_from_robot(optional<bool> value) { this->admitted_request_from_robot = std::move(value); }
+
+        const optional<int64_t> & get_calls() const { return calls; }
+        optional<int64_t> & get_mutable_calls() { return calls; }
+        void set_calls(optional<int64_t> value) { this->calls = std::move(value); }
+
+        const optional<bool> & get_door_open_at_goal_floor() const { return door_open_at_goal_floor; }
+        optional<bool> & get_mutable_door_open_at_goal_floor() { return door_open_at_goal_floor; }
+        void set_door_open_at_goal_floor(optional<bool> value) { this->door_open_at_goal_floor = std::move(value); }
+
+        const optional<bool> & get_door_open_at_start_floor() const { return door_open_at_start_floor; }
+        optional<bool> & get_mutable_door_open_at_start_floor() { return door_open_at_start_floor; }
+        void set_door_open_at_start_floor(optional<bool> value) { this->door_open_at_start_floor = std::move(value); }
+
+        const optional<bool> & get_door_waits_for_closing_command() const { return door_waits_for_closing_command; }
+        optional<bool> & get_mutable_door_waits_for_closing_command() { return door_waits_for_closing_command; }
+        void set_door_waits_for_closing_command(optional<bool> value) { this->door_waits_for_closing_command = std::move(value); }
+
+        const optional<std::vector<int64_t>> & get_elevator_ids() const { return elevator_ids; }
+        optional<std::vector<int64_t>> & get_mutable_elevator_ids() { return elevator_ids; }
+        void set_elevator_ids(optional<std::vector<int64_t>> value) { this->elevator_ids = std::move(value); }
+
+        const optional<int64_t> & get_floor() const { return floor; }
+        optional<int64_t> & get_mutable_floor() { return floor; }
+        void set_floor(optional<int64_t> value) { this->floor = std::move(value); }
+
+        const optional<int64_t> & get_id() const { return id; }
+        optional<int64_t> & get_mutable_id() { return id; }
+        void set_id(optional<int64_t> value) { this->id = std::move(value); }
+
+        const optional<bool> & get_is_available() const { return is_available; }
+        optional<bool> & get_mutable_is_available() { return is_available; }
+        void set_is_available(optional<bool> value) { this->is_available = std::move(value); }
+
+        const optional<Uuid> & get_query_id() const { return query_id; }
+        optional<Uuid> & get_mutable_query_id() { return query_id; }
+        void set_query_id(optional<Uuid> value) { this->query_id = std::move(value); }
+        optional<std::string> get_query_id_string() const {
+            optional<std::string> value;
+            if (query_id) emplace_optional(value) = query_id->to_string();
+            return value;
+        }
+        void set_query_id(const optional<std::string> & value) {
+            if (value) CheckConstraint("query_id", get_query_id_constraint(), *value);
+            this->query_id = optional<Uuid>();
+            if (value) Uuid::parse(*value, emplace_optional(this->query_id));
+        }
+
+        const optional<bool> & get_query_success() const { return query_success; }
+        optional<bool> & get_mutable_query_success() { return query_success; }
+        void set_query_success(optional<bool> value) { this->query_success = std::move(value); }
+
+        const optional<bool> & get_status_has_changed() const { return status_has_changed; }
+        optional<bool> & get_mutable_status_has_changed() { return status_has_changed; }
+        void set_status_has_changed(optional<bool> value) { this->status_has_changed = std::move(value); }
+
+        const optional<Query> & get_query() const { return query; }
+        optional<Query> & get_mutable_query() { return query; }
+        void set_query(optional<Query> value) { this->query = std::move(value); }
+    };
+
+    /**
+     * Status messages of an elevator
+     */
+    class RopodElevatorStatusSchema {
+        public:
+        RopodElevatorStatusSchema() = default;
+        RopodElevatorStatusSchema(const RopodElevatorStatusSchema &) = default;
+        RopodElevatorStatusSchema(RopodElevatorStatusSchema &&) = default;
+        RopodElevatorStatusSchema & operator=(const RopodElevatorStatusSchema &) = default;
+        RopodElevatorStatusSchema & operator=(RopodElevatorStatusSchema &&) = default;
+        virtual ~RopodElevatorStatusSchema() = default;
+
+        private:
+        Header header;
+        ElevatorStatusPayload payload;
+
+        public:
+        const Header & get_header() const { return header; }
+        Header & get_mutable_header() { return header; }
+        void set_header(Header value) { this->header = std::move(value); }
+
+        const ElevatorStatusPayload & get_payload() const { return payload; }
+        ElevatorStatusPayload & get_mutable_payload() { return payload; }
+        void set_payload(ElevatorStatusPayload value) { this->payload = std::move(value); }
+    };
+}
+}
+
+namespace quicktype {
+    /**
+     * The classes of this schema live in their own namespace so that several schemas can be
+     * used in one program; with only this schema included they are found as quicktype::X.
+     */
+    using namespace elevator_status;
+}
+
+namespace nlohmann {
+    void from_json(const json & j, quicktype::elevator_status::Header & x);
+    void to_json(json & j, const quicktype::elevator_status::Header & x);
+
+    void from_json(const json & j, quicktype::elevator_status::ElevatorStatusPayload & x);
+    void to_json(json & j, const quicktype::elevator_status::ElevatorStatusPayload & x);
+
+    void from_json(const json & j, quicktype::elevator_status::RopodElevatorStatusSchema & x);
+    void to_json(json & j, const quicktype::elevator_status::RopodElevatorStatusSchema & x);
+
+    void from_json(const json & j, quicktype::elevator_status::MsgMetamodel & x);
+    void to_json(json & j, const quicktype::elevator_status::MsgMetamodel & x);
+
+    void from_json(const json & j, quicktype::elevator_status::TypeEnum & x);
+    void to_json(json & j, const quicktype::elevator_status::TypeEnum & x);
+
+    void from_json(const json & j, quicktype::elevator_status::MetamodelEnum & x);
+    void to_json(json & j, const quicktype::elevator_status::MetamodelEnum & x);
+
+    void from_json(const json & j, quicktype::elevator_status::Query & x);
+    void to_json(json & j, const quicktype::elevator_status::Query & x);
+
+    inline void from_json(const json & j, quicktype::elevator_status::Header& x) {
+        uint32_t seen = 0;
+        for (const auto & member : j.get_ref<const json::object_t &>()) {
+            const std::string & key = member.first;
+            switch (quicktype::hash_key(key.data(), key.size())) {
+                case quicktype::hash_key("metamodel"):
+                    if (key != "metamodel") break;
+                    x.set_metamodel(member.second.get<quicktype::elevator_status::MsgMetamodel>());
+                    seen |= 1u << 0;
+                    break;
+                case quicktype::hash_key("msgId"):
+                    if (key != "msgId") break;
+                    x.set_msg_id(member.second.get<std::string>());
+                    seen |= 1u << 1;
+                    break;
+                case quicktype::hash_key("receiverIds"):
+                    if (key != "receiverIds") break;
+                    x.set_receiver_ids(member.second.get<quicktype::optional<std::vector<std::string>>>());
+                    seen |= 1u << 2;
+                    break;
+                case quicktype::hash_key("timestamp"):
+                    if (key != "timestamp") break;
+                    x.set_timestamp(member.second.get<quicktype::optional<quicktype::Instant>>());
+                    seen |= 1u << 3;
+                    break;
+                case quicktype::hash_key("type"):
+                    if (key != "type") break;
+                    x.set_type(member.second.get<quicktype::elevator_status::TypeEnum>());
+                    seen |= 1u << 4;
+                    break;
+                case quicktype::hash_key("version"):
+                    if (key != "version") break;
+                    x.set_version(member.second.get<quicktype::optional<std::string>>());
+                    seen |= 1u << 5;
+                    break;
+            }
+        }
+        if (!(seen & (1u << 0))) j.at("metamodel");
+        if (!(seen & (1u << 1))) j.at("msgId");
+        if (!(seen & (1u << 2))) x.set_receiver_ids(quicktype::optional<std::vector<std::string>>());
+        if (!(seen & (1u << 3))) x.set_timestamp(quicktype::optional<quicktype::Instant>());
+        if (!(seen & (1u << 4))) j.at("type");
+        if (!(seen & (1u << 5))) x.set_version(quicktype::optional<std::string>());
+    }
+
+    inline void to_json(json & j, const quicktype::elevator_status::Header & x) {
+        j = json::object();
+        j["metamodel"] = x.get_metamodel();
+        j["msgId"] = x.get_msg_id();
+        j["receiverIds"] = x.get_receiver_ids();
+        j["timestamp"] = x.get_timestamp();
+        j["type"] = x.get_type();
+        j["version"] = x.get_version();
+    }
+
+    inline void from_json(const json & j, quicktype::elevator_status::ElevatorStatusPayload& x) {
+        uint32_t seen = 0;
+        for (const auto & member : j.get_ref<const json::object_t &>()) {
+            const std::string & key = member.first;
+            switch (quicktype::hash_key(key.data(), key.size())) {
+                case quicktype::hash_key("metamodel"):
+                    if (key != "metamodel") break;
+                    x.set_metamodel(member.second.get<quicktype::elevator_status::MetamodelEnum>());
+                    seen |= 1u << 0;
+                    break;
+                case quicktype::hash_key("admittedRequestFromRobot"):
+                    if (key != "admittedRequestFromRobot") break;
+                    x.set_admitted_request_from_robot(member.second.get<quicktype::optional<bool>>());
+                    seen |= 1u << 1;
+                    break;
+                case quicktype::hash_key("calls"):
+                    if (key != "calls") break;
+                    x.set_calls(member.second.get<quicktype::optional<int64_t>>());
+                    seen |= 1u << 2;
+                    break;
+                case quicktype::hash_key("doorOpenAtGoalFloor"):
+                    if (key != "doorOpenAtGoalFloor") break;
+                    x.set_door_open_at_goal_floor(member.second.get<quicktype::optional<bool>>());
+                    seen |= 1u << 3;
+                    break;
+                case quicktype::hash_key("doorOpenAtStartFloor"):
+                    if (key != "doorOpenAtStartFloor") break;
+                    x.set_door_open_at_start_floor(member.second.get<quicktype::optional<bool>>());
+                    seen |= 1u << 4;
+                    break;
+                case quicktype::hash_key("doorWaitsForClosingCommand"):
+                    if (key != "doorWaitsForClosingCommand") break;
+                    x.set_door_waits_for_closing_command(member.second.get<quicktype::optional<bool>>());
+                    seen |= 1u << 5;
+                    break;
+                case quicktype::hash_key("elevatorIds"):
+                    if (key != "elevatorIds") break;
+                    x.set_elevator_ids(member.second.get<quicktype::optional<std::vector<int64_t>>>());
+                    seen |= 1u << 6;
+                    break;
+                case quicktype::hash_key("floor"):
+                    if (key != "floor") break;
+                    x.set_floor(member.second.get<quicktype::optional<int64_t>>());
+                    seen |= 1u << 7;
+                    break;
+                case quicktype::hash_key("id"):
+                    if (key != "id") break;
+                    x.set_id(member.second.get<quicktype::optional<int64_t>>());
+                    seen |= 1u << 8;
+                    break;
+                case quicktype::hash_key("isAvailable"):
+                    if (key != "isAvailable") break;
+                    x.set_is_available(member.second.get<quicktype::optional<bool>>());
+                    seen |= 1u << 9;
+                    break;
+                case quicktype::hash_key("queryId"):
+                    if (key != "queryId") break;
+                    x.set_query_id(member.second.get<quicktype::optional<std::string>>());
+                    seen |= 1u << 10;
+                    break;
+                case quicktype::hash_key("querySuccess"):
+                    if (key != "querySuccess") break;
+                    x.set_query_success(member.second.get<quicktype::optional<bool>>());
+                    seen |= 1u << 11;
+                    break;
+                case quicktype::hash_key("statusHasChanged"):
+                    if (key != "statusHasChanged") break;
+                    x.set_status_has_changed(member.second.get<quicktype::optional<bool>>());
+                    seen |= 1u << 12;
+                    break;
+                case quicktype::hash_key("query"):
+                    if (key != "query") break;
+                    x.set_query(member.second.get<quicktype::optional<quicktype::elevator_status::Query>>());
+                    seen |= 1u << 13;
+                    break;
+            }
+        }
+        if (!(seen & (1u << 0))) j.at("metamodel");
+        if (!(seen & (1u << 1))) x.set_admitted_request_from_robot(quicktype::optional<bool>());
+        if (!(seen & (1u << 2))) x.set_calls(quicktype::optional<int64_t>());
+        if (!(seen & (1u << 3))) x.set_door_open_at_goal_floor(quicktype::optional<bool>());
+        if (!(seen & (1u << 4))) x.set_door_open_at_start_floor(quicktype::optional<bool>());
+        if (!(seen & (1u << 5))) x.set_door_waits_for_closing_command(quicktype::optional<bool>());
+        if (!(seen & (1u << 6))) x.set_elevator_ids(quicktype::optional<std::vector<int64_t>>());
+        if (!(seen & (1u << 7))) x.set_floor(quicktype::optional<int64_t>());
+        if (!(seen & (1u << 8))) x.set_id(quicktype::optional<int64_t>());
+        if (!(seen & (1u << 9))) x.set_is_available(quicktype::optional<bool>());
+        if (!(seen & (1u << 10))) x.set_query_id(quicktype::optional<std::string>());
+        if (!(seen & (1u << 11))) x.set_query_success(quicktype::optional<bool>());
+        if (!(seen & (1u << 12))) x.set_status_has_changed(quicktype::optional<bool>());
+        if (!(seen & (1u << 13))) x.set_query(quicktype::optional<quicktype::elevator_status::Query>());
+    }
+
+    inline void to_json(json & j, const quicktype::elevator_status::ElevatorStatusPayload & x) {
+        j = json::object();
+        j["metamodel"] = x.get_metamodel();
+        j["admittedRequestFromRobot"] = x.get_admitted_request_from_robot();
+        j["calls"] = x.get_calls();
+        j["doorOpenAtGoalFloor"] = x.get_door_open_at_goal_floor();
+        j["doorOpenAtStartFloor"] = x.get_door_open_at_start_floor();
+        j["doorWaitsForClosingCommand"] = x.get_door_waits_for_closing_command();
+        j["elevatorIds"] = x.get_elevator_ids();
+        j["floor"] = x.get_floor();
+        j["id"] = x.get_id();
+        j["isAvailable"] = x.get_is_available();
+        j["queryId"] = x.get_query_id();
+        j["querySuccess"] = x.get_query_success();
+        j["statusHasChanged"] = x.get_status_has_changed();
+        j["query"] = x.get_query();
+    }
+
+    inline void from_json(const json & j, quicktype::elevator_status::RopodElevatorStatusSchema& x) {
+        uint32_t seen = 0;
+        for (const auto & member : j.get_ref<const json::object_t &>()) {
+            const std::string & key = member.first;
+            switch (quicktype::hash_key(key.data(), key.size())) {
+                case quicktype::hash_key("header"):
+                    if (key != "header") break;
+                    x.set_header(member.second.get<quicktype::elevator_status::Header>());
+                    seen |= 1u << 0;
+                    break;
+                case quicktype::hash_key("payload"):
+                    if (key != "payload") break;
+                    x.set_payload(member.second.get<quicktype::elevator_status::ElevatorStatusPayload>());
+                    seen |= 1u << 1;
+                    break;
+            }
+        }
+        if (!(seen & (1u << 0))) j.at("header");
+        if (!(seen & (1u << 1))) j.at("payload");
+    }
+
+    inline void to_json(json & j, const quicktype::elevator_status::RopodElevatorStatusSchema & x) {
+        j = json::object();
+        j["header"] = x.get_header();
+        j["payload"] = x.get_payload();
+    }
+
+    inline void from_json(const json & j, quicktype::elevator_status::MsgMetamodel & x) {
+        if (!j.is_string() || !quicktype::elevator_status::enum_from_name(j.get_ref<const std::string &>(), x)) throw "Input JSON does not conform to schema";
+    }
+
+    inline void to_json(json & j, const quicktype::elevator_status::MsgMetamodel & x) {
+        const boost::string_view name = quicktype::elevator_status::enum_name(x);
+        if (name.empty()) throw "This should not happen";
+        j = std::string(name.data(), name.size());
+    }
+
+    inline void from_json(const json & j, quicktype::elevator_status::TypeEnum & x) {
+        if (!j.is_string() || !quicktype::elevator_status::enum_from_name(j.get_ref<const std::string &>(), x)) throw "Input JSON does not conform to schema";
+    }
+
+    inline void to_json(json & j, const quicktype::elevator_status::TypeEnum & x) {
+        const boost::string_view name = quicktype::elevator_status::enum_name(x);
+        if (name.empty()) throw "This should not happen";
+        j = std::string(name.data(), name.size());
+    }
+
+    inline void from_json(const json & j, quicktype::elevator_status::MetamodelEnum & x) {
+        if (!j.is_string() || !quicktype::elevator_status::enum_from_name(j.get_ref<const std::string &>(), x)) throw "Input JSON does not conform to schema";
+    }
+
+    inline void to_json(json & j, const quicktype::elevator_status::MetamodelEnum & x) {
+        const boost::string_view name = quicktype::elevator_status::enum_name(x);
+        if (name.empty()) throw "This should not happen";
+        j = std::string(name.data(), name.size());
+    }
+
+    inline void from_json(const json & j, quicktype::elevator_status::Query & x) {
+        if (!j.is_string() || !quicktype::elevator_status::enum_from_name(j.get_ref<const std::string &>(), x)) throw "Input JSON does not conform to schema";
+    }
+
+    inline void to_json(json & j, const quicktype::elevator_status::Query & x) {
+        const boost::string_view name = quicktype::elevator_status::enum_name(x);
+        if (name.empty()) throw "This should not happen";
+        j = std::string(name.data(), name.size());
+    }
+}
+
+namespace quicktype {
+namespace elevator_status {
+    void read_json(JsonReader & r, Header & x);
+    void read_json(JsonReader & r, ElevatorStatusPayload & x);
+    void read_json(JsonReader & r, RopodElevatorStatusSchema & x);
+    void read_json(JsonReader & r, MsgMetamodel & x);
+    void read_json(JsonReader & r, TypeEnum & x);
+    void read_json(JsonReader & r, MetamodelEnum & x);
+    void read_json(JsonReader & r, Query & x);
+    void write_json(JsonWriter & w, const Header & x);
+    void write_json(JsonWriter & w, const ElevatorStatusPayload & x);
+    void write_json(JsonWriter & w, const RopodElevatorStatusSchema & x);
+    void write_json(JsonWriter & w, const MsgMetamodel & x);
+    void write_json(JsonWriter & w, const TypeEnum & x);
+    void write_json(JsonWriter & w, const MetamodelEnum & x);
+    void write_json(JsonWriter & w, const Query & x);
+    void read_packed(PackedReader & r, Header & x);
+    void read_packed(PackedReader & r, ElevatorStatusPayload & x);
+    void read_packed(PackedReader & r, RopodElevatorStatusSchema & x);
+    void read_packed(PackedReader & r, MsgMetamodel & x);
+    void read_packed(PackedReader & r, TypeEnum & x);
+    void read_packed(PackedReader & r, MetamodelEnum & x);
+    void read_packed(PackedReader & r, Query & x);
+    void write_packed(PackedWriter & w, const Header & x);
+    void write_packed(PackedWriter & w, const ElevatorStatusPayload & x);
+    void write_packed(PackedWriter & w, const RopodElevatorStatusSchema & x);
+    void write_packed(PackedWriter & w, const MsgMetamodel & x);
+    void write_packed(PackedWriter & w, const TypeEnum & x);
+    void write_packed(PackedWriter & w, const MetamodelEnum & x);
+    void write_packed(PackedWriter & w, const Query & x);
+    void skip_packed(PackedReader & r, PackedType<Header>);
+    void skip_packed(PackedReader & r, PackedType<ElevatorStatusPayload>);
+    void skip_packed(PackedReader & r, PackedType<RopodElevatorStatusSchema>);
+
+    inline void read_json(JsonReader & r, Header & x) {
+        uint32_t seen = 0;
+        if (!r.begin_object()) return;
+        boost::string_view key;
+        while (r.next_member(key)) {
+            switch (hash_key(key.data(), key.size())) {
+                case hash_key("metamodel"):
+                    if (key != "metamodel") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_metamodel());
+                    if (!r.ok()) {
+                        r.add_error_key("metamodel");
+                        return;
+                    }
+                    seen |= 1u << 0;
+                    break;
+                case hash_key("msgId"):
+                    if (key != "msgId") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_msg_id());
+                    if (!r.ok()) {
+                        r.add_error_key("msgId");
+                        return;
+                    }
+                    seen |= 1u << 1;
+                    break;
+                case hash_key("receiverIds"):
+                    if (key != "receiverIds") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_receiver_ids());
+                    if (!r.ok()) {
+                        r.add_error_key("receiverIds");
+                        return;
+                    }
+                    seen |= 1u << 2;
+                    break;
+                case hash_key("timestamp"):
+                    if (key != "timestamp") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_timestamp());
+                    if (!r.ok()) {
+                        r.add_error_key("timestamp");
+                        return;
+                    }
+                    seen |= 1u << 3;
+                    break;
+                case hash_key("type"):
+                    if (key != "type") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_type());
+                    if (!r.ok()) {
+                        r.add_error_key("type");
+                        return;
+                    }
+                    seen |= 1u << 4;
+                    break;
+                case hash_key("version"):
+                    if (key != "version") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_version());
+                    if (!r.ok()) {
+                        r.add_error_key("version");
+                        return;
+                    }
+                    seen |= 1u << 5;
+                    break;
+                default:
+                    r.skip_value();
+                    break;
+            }
+        }
+        if (!(seen & (1u << 0))) r.fail_missing_key("metamodel");
+        if (!(seen & (1u << 1))) r.fail_missing_key("msgId");
+        if (!(seen & (1u << 2))) x.get_mutable_receiver_ids() = optional<std::vector<std::string>>();
+        if (!(seen & (1u << 3))) x.get_mutable_timestamp() = TimeStamp();
+        if (!(seen & (1u << 4))) r.fail_missing_key("type");
+        if (!(seen & (1u << 5))) x.get_mutable_version() = optional<std::string>();
+    }
+
+    inline void read_json(JsonReader & r, ElevatorStatusPayload & x) {
+        uint32_t seen = 0;
+        if (!r.begin_object()) return;
+        boost::string_view key;
+        while (r.next_member(key)) {
+            switch (hash_key(key.data(), key.size())) {
+                case hash_key("metamodel"):
+                    if (key != "metamodel") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_metamodel());
+                    if (!r.ok()) {
+                        r.add_error_key("metamodel");
+                        return;
+                    }
+                    seen |= 1u << 0;
+                    break;
+                case hash_key("admittedRequestFromRobot"):
+                    if (key != "admittedRequestFromRobot") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_admitted_request_from_robot());
+                    if (!r.ok()) {
+                        r.add_error_key("admittedRequestFromRobot");
+                        return;
+                    }
+                    seen |= 1u << 1;
+                    break;
+                case hash_key("calls"):
+                    if (key != "calls") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_calls());
+                    if (!r.ok()) {
+                        r.add_error_key("calls");
+                        return;
+                    }
+                    seen |= 1u << 2;
+                    break;
+                case hash_key("doorOpenAtGoalFloor"):
+                    if (key != "doorOpenAtGoalFloor") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_door_open_at_goal_floor());
+                    if (!r.ok()) {
+                        r.add_error_key("doorOpenAtGoalFloor");
+                        return;
+                    }
+                    seen |= 1u << 3;
+                    break;
+                case hash_key("doorOpenAtStartFloor"):
+                    if (key != "doorOpenAtStartFloor") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_door_open_at_start_floor());
+                    if (!r.ok()) {
+                        r.add_error_key("doorOpenAtStartFloor");
+                        return;
+                    }
+                    seen |= 1u << 4;
+                    break;
+                case hash_key("doorWaitsForClosingCommand"):
+                    if (key != "doorWaitsForClosingCommand") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_door_waits_for_closing_command());
+                    if (!r.ok()) {
+                        r.add_error_key("doorWaitsForClosingCommand");
+                        return;
+                    }
+                    seen |= 1u << 5;
+                    break;
+                case hash_key("elevatorIds"):
+                    if (key != "elevatorIds") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_elevator_ids());
+                    if (!r.ok()) {
+                        r.add_error_key("elevatorIds");
+                        return;
+                    }
+                    seen |= 1u << 6;
+                    break;
+                case hash_key("floor"):
+                    if (key != "floor") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_floor());
+                    if (!r.ok()) {
+                        r.add_error_key("floor");
+                        return;
+                    }
+                    seen |= 1u << 7;
+                    break;
+                case hash_key("id"):
+                    if (key != "id") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_id());
+                    if (!r.ok()) {
+                        r.add_error_key("id");
+                        return;
+                    }
+                    seen |= 1u << 8;
+                    break;
+                case hash_key("isAvailable"):
+                    if (key != "isAvailable") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_is_available());
+                    if (!r.ok()) {
+                        r.add_error_key("isAvailable");
+                        return;
+                    }
+                    seen |= 1u << 9;
+                    break;
+                case hash_key("queryId"):
+                    if (key != "queryId") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_query_id());
+                    if (!r.ok()) {
+                        r.add_error_key("queryId");
+                        return;
+                    }
+                    seen |= 1u << 10;
+                    break;
+                case hash_key("querySuccess"):
+                    if (key != "querySuccess") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_query_success());
+                    if (!r.ok()) {
+                        r.add_error_key("querySuccess");
+                        return;
+                    }
+                    seen |= 1u << 11;
+                    break;
+                case hash_key("statusHasChanged"):
+                    if (key != "statusHasChanged") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_status_has_changed());
+                    if (!r.ok()) {
+                        r.add_error_key("statusHasChanged");
+                        return;
+                    }
+                    seen |= 1u << 12;
+                    break;
+                case hash_key("query"):
+                    if (key != "query") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_query());
+                    if (!r.ok()) {
+                        r.add_error_key("query");
+                        return;
+                    }
+                    seen |= 1u << 13;
+                    break;
+                default:
+                    r.skip_value();
+                    break;
+            }
+        }
+        if (!(seen & (1u << 0))) r.fail_missing_key("metamodel");
+        if (!(seen & (1u << 1))) x.get_mutable_admitted_request_from_robot() = optional<bool>();
+        if (!(seen & (1u << 2))) x.get_mutable_calls() = optional<int64_t>();
+        if (!(seen & (1u << 3))) x.get_mutable_door_open_at_goal_floor() = optional<bool>();
+        if (!(seen & (1u << 4))) x.get_mutable_door_open_at_start_floor() = optional<bool>();
+        if (!(seen & (1u << 5))) x.get_mutable_door_waits_for_closing_command() = optional<bool>();
+        if (!(seen & (1u << 6))) x.get_mutable_elevator_ids() = optional<std::vector<int64_t>>();
+        if (!(seen & (1u << 7))) x.get_mutable_floor() = optional<int64_t>();
+        if (!(seen & (1u << 8))) x.get_mutable_id() = optional<int64_t>();
+        if (!(seen & (1u << 9))) x.get_mutable_is_available() = optional<bool>();
+        if (!(seen & (1u << 10))) x.get_mutable_query_id() = optional<Uuid>();
+        if (!(seen & (1u << 11))) x.get_mutable_query_success() = optional<bool>();
+        if (!(seen & (1u << 12))) x.get_mutable_status_has_changed() = optional<bool>();
+        if (!(seen & (1u << 13))) x.get_mutable_query() = optional<Query>();
+    }
+
+    inline void read_json(JsonReader & r, RopodElevatorStatusSchema & x) {
+        uint32_t seen = 0;
+        if (!r.begin_object()) return;
+        boost::string_view key;
+        while (r.next_member(key)) {
+            switch (hash_key(key.data(), key.size())) {
+                case hash_key("header"):
+                    if (key != "header") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_header());
+                    if (!r.ok()) {
+                        r.add_error_key("header");
+                        return;
+                    }
+                    seen |= 1u << 0;
+                    break;
+                case hash_key("payload"):
+                    if (key != "payload") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_payload());
+                    if (!r.ok()) {
+                        r.add_error_key("payload");
+                        return;
+                    }
+                    seen |= 1u << 1;
+                    break;
+                default:
+                    r.skip_value();
+                    break;
+            }
+        }
+        if (!(seen & (1u << 0))) r.fail_missing_key("header");
+        if (!(seen & (1u << 1))) r.fail_missing_key("payload");
+    }
+
+    inline void read_json(JsonReader & r, MsgMetamodel & x) {
+        boost::string_view value;
+        r.read(value);
+        if (r.ok() && !enum_from_name(value, x)) r.fail(DecodeErrorKind::INVALID_ENUM_VALUE, "Input JSON does not conform to schema");
+    }
+
+    inline void read_json(JsonReader & r, TypeEnum & x) {
+        boost::string_view value;
+        r.read(value);
+        if (r.ok() && !enum_from_name(value, x)) r.fail(DecodeErrorKind::INVALID_ENUM_VALUE, "Input JSON does not conform to schema");
+    }
+
+    inline void read_json(JsonReader & r, MetamodelEnum & x) {
+        boost::string_view value;
+        r.read(value);
+        if (r.ok() && !enum_from_name(value, x)) r.fail(DecodeErrorKind::INVALID_ENUM_VALUE, "Input JSON does not conform to schema");
+    }
+
+    inline void read_json(JsonReader & r, Query & x) {
+        boost::string_view value;
+        r.read(value);
+        if (r.ok() && !enum_from_name(value, x)) r.fail(DecodeErrorKind::INVALID_ENUM_VALUE, "Input JSON does not conform to schema");
+    }
+
+    /**
+     * RopodElevatorStatusSchema whose payload is kept as raw JSON text and only decoded the first time
+     * get_payload() is called, for consumers that mostly look at the header. Decode it with
+     * decode<LazyRopodElevatorStatusSchema>(); get_payload() throws JsonDecodeException if the retained payload
+     * does not conform to the schema.
      */
-    class RopodElevatorStatusSchema {
+    class LazyRopodElevatorStatusSchema {
         public:
-        RopodElevatorStatusSchema() = default;
-        virtual ~RopodElevatorStatusSchema() = default;
+        LazyRopodElevatorStatusSchema() = default;
+        LazyRopodElevatorStatusSchema(const LazyRopodElevatorStatusSchema &) = default;
+        LazyRopodElevatorStatusSchema(LazyRopodElevatorStatusSchema &&) = default;
+        LazyRopodElevatorStatusSchema & operator=(const LazyRopodElevatorStatusSchema &) = default;
+        LazyRopodElevatorStatusSchema & operator=(LazyRopodElevatorStatusSchema &&) = default;
+        virtual ~LazyRopodElevatorStatusSchema() = default;
 
         private:
         Header header;
-        ElevatorStatusPayload payload;
+        Lazy<ElevatorStatusPayload> payload;
 
         public:
         const Header & get_header() const { return header; }
         Header & get_mutable_header() { return header; }
-        void set_header(const Header & value) { this->header = value; }
+        void set_header(Header value) { this->header = std::move(value); }
 
-        const ElevatorStatusPayload & get_payload() const { return payload; }
-        ElevatorStatusPayload & get_mutable_payload() { return payload; }
-        void set_payload(const ElevatorStatusPayload & value) { this->payload = value; }
+        const ElevatorStatusPayload & get_payload() const { return payload.get(); }
+        const std::string & get_payload_text() const { return payload.get_text(); }
+        Lazy<ElevatorStatusPayload> & get_mutable_payload() { return payload; }
+        void set_payload(Lazy<ElevatorStatusPayload> value) { this->payload = std::move(value); }
     };
-}
 
-namespace nlohmann {
-    void from_json(const json & j, quicktype::Header & x);
-    void to_json(json & j, const quicktype::Header & x);
+    inline void read_json(JsonReader & r, LazyRopodElevatorStatusSchema & x) {
+        uint32_t seen = 0;
+        if (!r.begin_object()) return;
+        boost::string_view key;
+        while (r.next_member(key)) {
+            switch (hash_key(key.data(), key.size())) {
+                case hash_key("header"):
+                    if (key != "header") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_header());
+                    if (!r.ok()) {
+                        r.add_error_key("header");
+                        return;
+                    }
+                    seen |= 1u << 0;
+                    break;
+                case hash_key("payload"):
+                    if (key != "payload") {
+                        r.skip_value();
+                        break;
+                    }
+                    read_json(r, x.get_mutable_payload());
+                    if (!r.ok()) {
+                        r.add_error_key("payload");
+                        return;
+                    }
+                    seen |= 1u << 1;
+                    break;
+                default:
+                    r.skip_value();
+                    break;
+            }
+        }
+        if (!(seen & (1u << 0))) r.fail_missing_key("header");
+        if (!(seen & (1u << 1))) r.fail_missing_key("payload");
+    }
 
-    void from_json(const json & j, quicktype::ElevatorStatusPayload & x);
-    void to_json(json & j, const quicktype::ElevatorStatusPayload & x);
+    inline void write_json(JsonWriter & w, const Header & x) {
+        w.raw('{');
+        w.key(",\"metamodel\":");
+        write_json(w, x.get_metamodel());
+        w.key(",\"msgId\":");
+        write_json(w, x.get_msg_id());
+        if (w.writes(x.get_receiver_ids())) {
+            w.key(",\"receiverIds\":");
+            write_json(w, x.get_receiver_ids());
+        }
+        if (w.writes(x.get_timestamp())) {
+            w.key(",\"timestamp\":");
+            write_json(w, x.get_timestamp());
+        }
+        w.key(",\"type\":");
+        write_json(w, x.get_type());
+        if (w.writes(x.get_version())) {
+            w.key(",\"version\":");
+            write_json(w, x.get_version());
+        }
+        w.raw('}');
+    }
 
-    void from_json(const json & j, quicktype::RopodElevatorStatusSchema & x);
-    void to_json(json & j, const quicktype::RopodElevatorStatusSchema & x);
+    inline void write_json(JsonWriter & w, const ElevatorStatusPayload & x) {
+        w.raw('{');
+        if (w.writes(x.get_admitted_request_from_robot())) {
+            w.key(",\"admittedRequestFromRobot\":");
+            write_json(w, x.get_admitted_request_from_robot());
+        }
+        if (w.writes(x.get_calls())) {
+            w.key(",\"calls\":");
+            write_json(w, x.get_calls());
+        }
+        if (w.writes(x.get_door_open_at_goal_floor())) {
+            w.key(",\"doorOpenAtGoalFloor\":");
+            write_json(w, x.get_door_open_at_goal_floor());
+        }
+        if (w.writes(x.get_door_open_at_start_floor())) {
+            w.key(",\"doorOpenAtStartFloor\":");
+            write_json(w, x.get_door_open_at_start_floor());
+        }
+        if (w.writes(x.get_door_waits_for_closing_command())) {
+            w.key(",\"doorWaitsForClosingCommand\":");
+            write_json(w, x.get_door_waits_for_closing_command());
+        }
+        if (w.writes(x.get_elevator_ids())) {
+            w.key(",\"elevatorIds\":");
+            write_json(w, x.get_elevator_ids());
+        }
+        if (w.writes(x.get_floor())) {
+            w.key(",\"floor\":");
+            write_json(w, x.get_floor());
+        }
+        if (w.writes(x.get_id())) {
+            w.key(",\"id\":");
+            write_json(w, x.get_id());
+        }
+        if (w.writes(x.get_is_available())) {
+            w.key(",\"isAvailable\":");
+            write_json(w, x.get_is_available());
+        }
+        w.key(",\"metamodel\":");
+        write_json(w, x.get_metamodel());
+        if (w.writes(x.get_query())) {
+            w.key(",\"query\":");
+            write_json(w, x.get_query());
+        }
+        if (w.writes(x.get_query_id())) {
+            w.key(",\"queryId\":");
+            write_json(w, x.get_query_id());
+        }
+        if (w.writes(x.get_query_success())) {
+            w.key(",\"querySuccess\":");
+            write_json(w, x.get_query_success());
+        }
+        if (w.writes(x.get_status_has_changed())) {
+            w.key(",\"statusHasChanged\":");
+            write_json(w, x.get_status_has_changed());
+        }
+        w.raw('}');
+    }
 
-    void from_json(const json & j, quicktype::MsgMetamodel & x);
-    void to_json(json & j, const quicktype::MsgMetamodel & x);
+    inline void write_json(JsonWriter & w, const RopodElevatorStatusSchema & x) {
+        w.raw('{');
+        w.key(",\"header\":");
+        write_json(w, x.get_header());
+        w.key(",\"payload\":");
+        write_json(w, x.get_payload());
+        w.raw('}');
+    }
 
-    void from_json(const json & j, quicktype::TypeEnum & x);
-    void to_json(json & j, const quicktype::TypeEnum & x);
+    inline void write_json(JsonWriter & w, const MsgMetamodel & x) {
+        const boost::string_view name = enum_name(x);
+        if (name.empty()) throw "This should not happen";
+        w.write_string(name);
+    }
 
-    void from_json(const json & j, quicktype::MetamodelEnum & x);
-    void to_json(json & j, const quicktype::MetamodelEnum & x);
+    inline void write_json(JsonWriter & w, const TypeEnum & x) {
+        const boost::string_view name = enum_name(x);
+        if (name.empty()) throw "This should not happen";
+        w.write_string(name);
+    }
 
-    void from_json(const json & j, quicktype::Query & x);
-    void to_json(json & j, const quicktype::Query & x);
-    void from_json(const json & j, boost::variant<double, std::string> & x);
-    void to_json(json & j, const boost::variant<double, std::string> & x);
+    inline void write_json(JsonWriter & w, const MetamodelEnum & x) {
+        const boost::string_view name = enum_name(x);
+        if (name.empty()) throw "This should not happen";
+        w.write_string(name);
+    }
 
-    inline void from_json(const json & j, quicktype::Header& x) {
-        x.set_metamodel(j.at("metamodel").get<quicktype::MsgMetamodel>());
-        x.set_msg_id(j.at("msgId").get<std::string>());
-        x.set_receiver_ids(quicktype::get_optional<std::vector<std::string>>(j, "receiverIds"));
-        x.set_timestamp(quicktype::get_optional<boost::variant<double, std::string>>(j, "timestamp"));
-        x.set_type(j.at("type").get<quicktype::TypeEnum>());
-        x.set_version(quicktype::get_optional<std::string>(j, "version"));
+    inline void write_json(JsonWriter & w, const Query & x) {
+        const boost::string_view name = enum_name(x);
+        if (name.empty()) throw "This should not happen";
+        w.write_string(name);
     }
 
-    inline void to_json(json & j, const quicktype::Header & x) {
-        j = json::object();
-        j["metamodel"] = x.get_metamodel();
-        j["msgId"] = x.get_msg_id();
-        j["receiverIds"] = x.get_receiver_ids();
-        j["timestamp"] = x.get_timestamp();
-        j["type"] = x.get_type();
-        j["version"] = x.get_version();
+    inline void read_packed(PackedReader & r, Header & x) {
+        const uint32_t present = r.read_bitmap(3);
+        read_packed(r, x.get_mutable_metamodel());
+        if (!r.ok()) {
+            r.add_error_key("metamodel");
+            return;
+        }
+        read_packed(r, x.get_mutable_msg_id());
+        if (!r.ok()) {
+            r.add_error_key("msgId");
+            return;
+        }
+        if (present & (1u << 0)) {
+            read_packed(r, emplace_optional(x.get_mutable_receiver_ids()));
+            if (!r.ok()) {
+                r.add_error_key("receiverIds");
+                return;
+            }
+        } else {
+            x.get_mutable_receiver_ids() = optional<std::vector<std::string>>();
+        }
+        if (present & (1u << 1)) {
+            read_packed(r, emplace_optional(x.get_mutable_timestamp()));
+            if (!r.ok()) {
+                r.add_error_key("timestamp");
+                return;
+            }
+        } else {
+            x.get_mutable_timestamp() = TimeStamp();
+        }
+        read_packed(r, x.get_mutable_type());
+        if (!r.ok()) {
+            r.add_error_key("type");
+            return;
+        }
+        if (present & (1u << 2)) {
+            read_packed(r, emplace_optional(x.get_mutable_version()));
+            if (!r.ok()) {
+                r.add_error_key("version");
+                return;
+            }
+        } else {
+            x.get_mutable_version() = optional<std::string>();
+        }
     }
 
-    inline void from_json(const json & j, quicktype::ElevatorStatusPayload& x) {
-        x.set_metamodel(j.at("metamodel").get<quicktype::MetamodelEnum>());
-        x.set_admitted_request_from_robot(quicktype::get_optional<bool>(j, "admittedRequestFromRobot"));
-        x.set_calls(quicktype::get_optional<int64_t>(j, "calls"));
-        x.set_door_open_at_goal_floor(quicktype::get_optional<bool>(j, "doorOpenAtGoalFloor"));
-        x.set_door_open_at_start_floor(quicktype::get_optional<bool>(j, "doorOpenAtStartFloor"));
-        x.set_door_waits_for_closing_command(quicktype::get_optional<bool>(j, "doorWaitsForClosingCommand"));
-        x.set_elevator_ids(quicktype::get_optional<std::vector<int64_t>>(j, "elevatorIds"));
-        x.set_floor(quicktype::get_optional<int64_t>(j, "floor"));
-        x.set_id(quicktype::get_optional<int64_t>(j, "id"));
-        x.set_is_available(quicktype::get_optional<bool>(j, "isAvailable"));
-        x.set_query_id(quicktype::get_optional<std::string>(j, "queryId"));
-        x.set_query_success(quicktype::get_optional<bool>(j, "querySuccess"));
-        x.set_status_has_changed(quicktype::get_optional<bool>(j, "statusHasChanged"));
-        x.set_query(quicktype::get_optional<quicktype::Query>(j, "query"));
-    }
-
-    inline void to_json(json & j, const quicktype::ElevatorStatusPayload & x) {
-        j = json::object();
-        j["metamodel"] = x.get_metamodel();
-        j["admittedRequestFromRobot"] = x.get_admitted_request_from_robot();
-        j["calls"] = x.get_calls();
-        j["doorOpenAtGoalFloor"] = x.get_door_open_at_goal_floor();
-        j["doorOpenAtStartFloor"] = x.get_door_open_at_start_floor();
-        j["doorWaitsForClosingCommand"] = x.get_door_waits_for_closing_command();
-        j["elevatorIds"] = x.get_elevator_ids();
-        j["floor"] = x.get_floor();
-        j["id"] = x.get_id();
-        j["isAvailable"] = x.get_is_available();
-        j["queryId"] = x.get_query_id();
-        j["querySuccess"] = x.get_query_success();
-        j["statusHasChanged"] = x.get_status_has_changed();
-        j["query"] = x.get_query();
+    inline void read_packed(PackedReader & r, ElevatorStatusPayload & x) {
+        const uint32_t present = r.read_bitmap(13);
+        read_packed(r, x.get_mutable_metamodel());
+        if (!r.ok()) {
+            r.add_error_key("metamodel");
+            return;
+        }
+        if (present & (1u << 0)) {
+            read_packed(r, emplace_optional(x.get_mutable_admitted_request_from_robot()));
+            if (!r.ok()) {
+                r.add_error_key("admittedRequestFromRobot");
+                return;
+            }
+        } else {
+            x.get_mutable_admitted_request_from_robot() = optional<bool>();
+        }
+        if (present & (1u << 1)) {
+            read_packed(r, emplace_optional(x.get_mutable_calls()));
+            if (!r.ok()) {
+                r.add_error_key("calls");
+                return;
+            }
+        } else {
+            x.get_mutable_calls() = optional<int64_t>();
+        }
+        if (present & (1u << 2)) {
+            read_packed(r, emplace_optional(x.get_mutable_door_open_at_goal_floor()));
+            if (!r.ok()) {
+                r.add_error_key("doorOpenAtGoalFloor");
+                return;
+            }
+        } else {
+            x.get_mutable_door_open_at_goal_floor() = optional<bool>();
+        }
+        if (present & (1u << 3)) {
+            read_packed(r, emplace_optional(x.get_mutable_door_open_at_start_floor()));
+            if (!r.ok()) {
+                r.add_error_key("doorOpenAtStartFloor");
+                return;
+            }
+        } else {
+            x.get_mutable_door_open_at_start_floor() = optional<bool>();
+        }
+        if (present & (1u << 4)) {
+            read_packed(r, emplace_optional(x.get_mutable_door_waits_for_closing_command()));
+            if (!r.ok()) {
+                r.add_error_key("doorWaitsForClosingCommand");
+                return;
+            }
+        } else {
+            x.get_mutable_door_waits_for_closing_command() = optional<bool>();
+        }
+        if (present & (1u << 5)) {
+            read_packed(r, emplace_optional(x.get_mutable_elevator_ids()));
+            if (!r.ok()) {
+                r.add_error_key("elevatorIds");
+                return;
+            }
+        } else {
+            x.get_mutable_elevator_ids() = optional<std::vector<int64_t>>();
+        }
+        if (present & (1u << 6)) {
+            read_packed(r, emplace_optional(x.get_mutable_floor()));
+            if (!r.ok()) {
+                r.add_error_key("floor");
+                return;
+            }
+        } else {
+            x.get_mutable_floor() = optional<int64_t>();
+        }
+        if (present & (1u << 7)) {
+            read_packed(r, emplace_optional(x.get_mutable_id()));
+            if (!r.ok()) {
+                r.add_error_key("id");
+                return;
+            }
+        } else {
+            x.get_mutable_id() = optional<int64_t>();
+        }
+        if (present & (1u << 8)) {
+            read_packed(r, emplace_optional(x.get_mutable_is_available()));
+            if (!r.ok()) {
+                r.add_error_key("isAvailable");
+                return;
+            }
+        } else {
+            x.get_mutable_is_available() = optional<bool>();
+        }
+        if (present & (1u << 9)) {
+            read_packed(r, emplace_optional(x.get_mutable_query_id()));
+            if (!r.ok()) {
+                r.add_error_key("queryId");
+                return;
+            }
+        } else {
+            x.get_mutable_query_id() = optional<Uuid>();
+        }
+        if (present & (1u << 10)) {
+            read_packed(r, emplace_optional(x.get_mutable_query_success()));
+            if (!r.ok()) {
+                r.add_error_key("querySuccess");
+                return;
+            }
+        } else {
+            x.get_mutable_query_success() = optional<bool>();
+        }
+        if (present & (1u << 11)) {
+            read_packed(r, emplace_optional(x.get_mutable_status_has_changed()));
+            if (!r.ok()) {
+                r.add_error_key("statusHasChanged");
+                return;
+            }
+        } else {
+            x.get_mutable_status_has_changed() = optional<bool>();
+        }
+        if (present & (1u << 12)) {
+            read_packed(r, emplace_optional(x.get_mutable_query()));
+            if (!r.ok()) {
+                r.add_error_key("query");
+                return;
+            }
+        } else {
+            x.get_mutable_query() = optional<Query>();
+        }
     }
 
-    inline void from_json(const json & j, quicktype::RopodElevatorStatusSchema& x) {
-        x.set_header(j.at("header").get<quicktype::Header>());
-        x.set_payload(j.at("payload").get<quicktype::ElevatorStatusPayload>());
+    inline void read_packed(PackedReader & r, RopodElevatorStatusSchema & x) {
+        read_packed(r, x.get_mutable_header());
+        if (!r.ok()) {
+            r.add_error_key("header");
+            return;
+        }
+        read_packed(r, x.get_mutable_payload());
+        if (!r.ok()) {
+            r.add_error_key("payload");
+            return;
+        }
     }
 
-    inline void to_json(json & j, const quicktype::RopodElevatorStatusSchema & x) {
-        j = json::object();
-        j["header"] = x.get_header();
-        j["payload"] = x.get_payload();
+    inline void read_packed(PackedReader &, MsgMetamodel & x) { x = MsgMetamodel::ROPOD_MSG_SCHEMA_JSON; }
+
+    inline void read_packed(PackedReader & r, TypeEnum & x) {
+        const uint64_t value = r.read_varint();
+        if (!r.ok()) return;
+        if (value > static_cast<uint64_t>(TypeEnum::ELEVATOR_STATUS_QUERY)) r.fail(DecodeErrorKind::INVALID_ENUM_VALUE, "Input does not conform to schema");
+        else x = static_cast<TypeEnum>(value);
     }
 
-    inline void from_json(const json & j, quicktype::MsgMetamodel & x) {
-        if (j == "ropod-msg-schema.json") x = quicktype::MsgMetamodel::ROPOD_MSG_SCHEMA_JSON;
-        else throw "Input JSON does not conform to schema";
+    inline void read_packed(PackedReader &, MetamodelEnum & x) { x = MetamodelEnum::ROPOD_ELEVATOR_STATUS_SCHEMA_JSON; }
+
+    inline void read_packed(PackedReader & r, Query & x) {
+        const uint64_t value = r.read_varint();
+        if (!r.ok()) return;
+        if (value > static_cast<uint64_t>(Query::GET_ELEVATOR_STATUS)) r.fail(DecodeErrorKind::INVALID_ENUM_VALUE, "Input does not conform to schema");
+        else x = static_cast<Query>(value);
     }
 
-    inline void to_json(json & j, const quicktype::MsgMetamodel & x) {
-        switch (x) {
-            case quicktype::MsgMetamodel::ROPOD_MSG_SCHEMA_JSON: j = "ropod-msg-schema.json"; break;
-            default: throw "This should not happen";
-        }
+    inline void write_packed(PackedWriter & w, const Header & x) {
+        uint32_t present = 0;
+        if (x.get_receiver_ids()) present |= 1u << 0;
+        if (x.get_timestamp()) present |= 1u << 1;
+        if (x.get_version()) present |= 1u << 2;
+        w.write_bitmap(present, 3);
+        write_packed(w, x.get_metamodel());
+        write_packed(w, x.get_msg_id());
+        if (present & (1u << 0)) write_packed(w, *x.get_receiver_ids());
+        if (present & (1u << 1)) write_packed(w, *x.get_timestamp());
+        write_packed(w, x.get_type());
+        if (present & (1u << 2)) write_packed(w, *x.get_version());
     }
 
-    inline void from_json(const json & j, quicktype::TypeEnum & x) {
-        if (j == "ELEVATOR-STATUS") x = quicktype::TypeEnum::ELEVATOR_STATUS;
-        else if (j == "ELEVATOR-STATUS-QUERY") x = quicktype::TypeEnum::ELEVATOR_STATUS_QUERY;
-        else throw "Input JSON does not conform to schema";
+    inline void write_packed(PackedWriter & w, const ElevatorStatusPayload & x) {
+        uint32_t present = 0;
+        if (x.get_admitted_request_from_robot()) present |= 1u << 0;
+        if (x.get_calls()) present |= 1u << 1;
+        if (x.get_door_open_at_goal_floor()) present |= 1u << 2;
+        if (x.get_door_open_at_start_floor()) present |= 1u << 3;
+        if (x.get_door_waits_for_closing_command()) present |= 1u << 4;
+        if (x.get_elevator_ids()) present |= 1u << 5;
+        if (x.get_floor()) present |= 1u << 6;
+        if (x.get_id()) present |= 1u << 7;
+        if (x.get_is_available()) present |= 1u << 8;
+        if (x.get_query_id()) present |= 1u << 9;
+        if (x.get_query_success()) present |= 1u << 10;
+        if (x.get_status_has_changed()) present |= 1u << 11;
+        if (x.get_query()) present |= 1u << 12;
+        w.write_bitmap(present, 13);
+        write_packed(w, x.get_metamodel());
+        if (present & (1u << 0)) write_packed(w, *x.get_admitted_request_from_robot());
+        if (present & (1u << 1)) write_packed(w, *x.get_calls());
+        if (present & (1u << 2)) write_packed(w, *x.get_door_open_at_goal_floor());
+        if (present & (1u << 3)) write_packed(w, *x.get_door_open_at_start_floor());
+        if (present & (1u << 4)) write_packed(w, *x.get_door_waits_for_closing_command());
+        if (present & (1u << 5)) write_packed(w, *x.get_elevator_ids());
+        if (present & (1u << 6)) write_packed(w, *x.get_floor());
+        if (present & (1u << 7)) write_packed(w, *x.get_id());
+        if (present & (1u << 8)) write_packed(w, *x.get_is_available());
+        if (present & (1u << 9)) write_packed(w, *x.get_query_id());
+        if (present & (1u << 10)) write_packed(w, *x.get_query_success());
+        if (present & (1u << 11)) write_packed(w, *x.get_status_has_changed());
+        if (present & (1u << 12)) write_packed(w, *x.get_query());
     }
 
-    inline void to_json(json & j, const quicktype::TypeEnum & x) {
-        switch (x) {
-            case quicktype::TypeEnum::ELEVATOR_STATUS: j = "ELEVATOR-STATUS"; break;
-            case quicktype::TypeEnum::ELEVATOR_STATUS_QUERY: j = "ELEVATOR-STATUS-QUERY"; break;
-            default: throw "This should not happen";
-        }
+    inline void write_packed(PackedWriter & w, const RopodElevatorStatusSchema & x) {
+        write_packed(w, x.get_header());
+        write_packed(w, x.get_payload());
     }
 
-    inline void from_json(const json & j, quicktype::MetamodelEnum & x) {
-        if (j == "ropod-elevator-status-schema.json") x = quicktype::MetamodelEnum::ROPOD_ELEVATOR_STATUS_SCHEMA_JSON;
-        else throw "Input JSON does not conform to schema";
+    inline void write_packed(PackedWriter &, const MsgMetamodel &) {}
+
+    inline void write_packed(PackedWriter & w, const TypeEnum & x) {
+        const int value = static_cast<int>(x);
+        if (value < 0 || value > static_cast<int>(TypeEnum::ELEVATOR_STATUS_QUERY)) throw "This should not happen";
+        w.write_varint(static_cast<uint64_t>(value));
     }
 
-    inline void to_json(json & j, const quicktype::MetamodelEnum & x) {
-        switch (x) {
-            case quicktype::MetamodelEnum::ROPOD_ELEVATOR_STATUS_SCHEMA_JSON: j = "ropod-elevator-status-schema.json"; break;
-            default: throw "This should not happen";
+    inline void write_packed(PackedWriter &, const MetamodelEnum &) {}
+
+    inline void write_packed(PackedWriter & w, const Query & x) {
+        const int value = static_cast<int>(x);
+        if (value < 0 || value > static_cast<int>(Query::GET_ELEVATOR_STATUS)) throw "This should not happen";
+        w.write_varint(static_cast<uint64_t>(value));
+    }
+
+    /**
+     * Read-only view of a packed Header.
+     */
+    class HeaderView {
+        private:
+        const uint8_t * data = nullptr;
+        size_t size = 0;
+
+        uint32_t present_members() const {
+            PackedReader r(data, size);
+            return r.read_bitmap(3);
+        }
+
+        PackedReader member(size_t index) const {
+            PackedReader r(data, size);
+            const uint32_t present = r.read_bitmap(3);
+            if (index > 0) skip_packed(r, PackedType<MsgMetamodel>());
+            if (index > 1) skip_packed(r, PackedType<Uuid>());
+            if (index > 2 && (present & (1u << 0))) skip_packed(r, PackedType<std::vector<std::string>>());
+            if (index > 3 && (present & (1u << 1))) skip_packed(r, PackedType<Instant>());
+            if (index > 4) skip_packed(r, PackedType<TypeEnum>());
+            return r;
+        }
+
+        public:
+        HeaderView() = default;
+        HeaderView(const uint8_t * data, size_t size) : data(data), size(size) {}
+
+        MsgMetamodel get_metamodel() const {
+            PackedReader r = member(0);
+            return read_view(r, PackedType<MsgMetamodel>());
+        }
+
+        Uuid get_msg_id() const {
+            PackedReader r = member(1);
+            return read_view(r, PackedType<Uuid>());
+        }
+
+        boost::optional<PackedListView<std::string>> get_receiver_ids() const {
+            if (!(present_members() & (1u << 0))) return boost::none;
+            PackedReader r = member(2);
+            return read_view(r, PackedType<std::vector<std::string>>());
+        }
+
+        boost::optional<Instant> get_timestamp() const {
+            if (!(present_members() & (1u << 1))) return boost::none;
+            PackedReader r = member(3);
+            return read_view(r, PackedType<Instant>());
+        }
+
+        TypeEnum get_type() const {
+            PackedReader r = member(4);
+            return read_view(r, PackedType<TypeEnum>());
+        }
+
+        boost::optional<boost::string_view> get_version() const {
+            if (!(present_members() & (1u << 2))) return boost::none;
+            PackedReader r = member(5);
+            return read_view(r, PackedType<std::string>());
+        }
+    };
+
+    inline void skip_packed(PackedReader & r, PackedType<Header>) {
+        const uint32_t present = r.read_bitmap(3);
+        skip_packed(r, PackedType<MsgMetamodel>());
+        if (!r.ok()) {
+            r.add_error_key("metamodel");
+            return;
+        }
+        skip_packed(r, PackedType<Uuid>());
+        if (!r.ok()) {
+            r.add_error_key("msgId");
+            return;
+        }
+        if (present & (1u << 0)) {
+            skip_packed(r, PackedType<std::vector<std::string>>());
+            if (!r.ok()) {
+                r.add_error_key("receiverIds");
+                return;
+            }
+        }
+        if (present & (1u << 1)) {
+            skip_packed(r, PackedType<Instant>());
+            if (!r.ok()) {
+                r.add_error_key("timestamp");
+                return;
+            }
+        }
+        skip_packed(r, PackedType<TypeEnum>());
+        if (!r.ok()) {
+            r.add_error_key("type");
+            return;
+        }
+        if (present & (1u << 2)) {
+            skip_packed(r, PackedType<std::string>());
+            if (!r.ok()) {
+                r.add_error_key("version");
+                return;
+            }
         }
     }
 
-    inline void from_json(const json & j, quicktype::Query & x) {
-        if (j == "GET_ALL_ELEVATOR_IDS") x = quicktype::Query::GET_ALL_ELEVATOR_IDS;
-        else if (j == "GET_ELEVATOR_STATUS") x = quicktype::Query::GET_ELEVATOR_STATUS;
-        else throw "Input JSON does not conform to schema";
+    inline HeaderView read_view(PackedReader & r, PackedType<Header>) {
+        return HeaderView(r.current(), r.remaining());
     }
 
-    inline void to_json(json & j, const quicktype::Query & x) {
-        switch (x) {
-            case quicktype::Query::GET_ALL_ELEVATOR_IDS: j = "GET_ALL_ELEVATOR_IDS"; break;
-            case quicktype::Query::GET_ELEVATOR_STATUS: j = "GET_ELEVATOR_STATUS"; break;
-            default: throw "This should not happen";
+    /**
+     * Read-only view of a packed ElevatorStatusPayload.
+     */
+    class ElevatorStatusPayloadView {
+        private:
+        const uint8_t * data = nullptr;
+        size_t size = 0;
+
+        uint32_t present_members() const {
+            PackedReader r(data, size);
+            return r.read_bitmap(13);
+        }
+
+        PackedReader member(size_t index) const {
+            PackedReader r(data, size);
+            const uint32_t present = r.read_bitmap(13);
+            if (index > 0) skip_packed(r, PackedType<MetamodelEnum>());
+            if (index > 1 && (present & (1u << 0))) skip_packed(r, PackedType<bool>());
+            if (index > 2 && (present & (1u << 1))) skip_packed(r, PackedType<int64_t>());
+            if (index > 3 && (present & (1u << 2))) skip_packed(r, PackedType<bool>());
+            if (index > 4 && (present & (1u << 3))) skip_packed(r, PackedType<bool>());
+            if (index > 5 && (present & (1u << 4))) skip_packed(r, PackedType<bool>());
+            if (index > 6 && (present & (1u << 5))) skip_packed(r, PackedType<std::vector<int64_t>>());
+            if (index > 7 && (present & (1u << 6))) skip_packed(r, PackedType<int64_t>());
+            if (index > 8 && (present & (1u << 7))) skip_packed(r, PackedType<int64_t>());
+            if (index > 9 && (present & (1u << 8))) skip_packed(r, PackedType<bool>());
+            if (index > 10 && (present & (1u << 9))) skip_packed(r, PackedType<Uuid>());
+            if (index > 11 && (present & (1u << 10))) skip_packed(r, PackedType<bool>());
+            if (index > 12 && (present & (1u << 11))) skip_packed(r, PackedType<bool>());
+            return r;
+        }
+
+        public:
+        ElevatorStatusPayloadView() = default;
+        ElevatorStatusPayloadView(const uint8_t * data, size_t size) : data(data), size(size) {}
+
+        MetamodelEnum get_metamodel() const {
+            PackedReader r = member(0);
+            return read_view(r, PackedType<MetamodelEnum>());
+        }
+
+        boost::optional<bool> get_admitted_request_from_robot() const {
+            if (!(present_members() & (1u << 0))) return boost::none;
+            PackedReader r = member(1);
+            return read_view(r, PackedType<bool>());
+        }
+
+        boost::optional<int64_t> get_calls() const {
+            if (!(present_members() & (1u << 1))) return boost::none;
+            PackedReader r = member(2);
+            return read_view(r, PackedType<int64_t>());
+        }
+
+        boost::optional<bool> get_door_open_at_goal_floor() const {
+            if (!(present_members() & (1u << 2))) return boost::none;
+            PackedReader r = member(3);
+            return read_view(r, PackedType<bool>());
+        }
+
+        boost::optional<bool> get_door_open_at_start_floor() const {
+            if (!(present_members() & (1u << 3))) return boost::none;
+            PackedReader r = member(4);
+            return read_view(r, PackedType<bool>());
+        }
+
+        boost::optional<bool> get_door_waits_for_closing_command() const {
+            if (!(present_members() & (1u << 4))) return boost::none;
+            PackedReader r = member(5);
+            return read_view(r, PackedType<bool>());
+        }
+
+        boost::optional<PackedListView<int64_t>> get_elevator_ids() const {
+            if (!(present_members() & (1u << 5))) return boost::none;
+            PackedReader r = member(6);
+            return read_view(r, PackedType<std::vector<int64_t>>());
+        }
+
+        boost::optional<int64_t> get_floor() const {
+            if (!(present_members() & (1u << 6))) return boost::none;
+            PackedReader r = member(7);
+            return read_view(r, PackedType<int64_t>());
+        }
+
+        boost::optional<int64_t> get_id() const {
+            if (!(present_members() & (1u << 7))) return boost::none;
+            PackedReader r = member(8);
+            return read_view(r, PackedType<int64_t>());
+        }
+
+        boost::optional<bool> get_is_available() const {
+            if (!(present_members() & (1u << 8))) return boost::none;
+            PackedReader r = member(9);
+            return read_view(r, PackedType<bool>());
+        }
+
+        boost::optional<Uuid> get_query_id() const {
+            if (!(present_members() & (1u << 9))) return boost::none;
+            PackedReader r = member(10);
+            return read_view(r, PackedType<Uuid>());
+        }
+
+        boost::optional<bool> get_query_success() const {
+            if (!(present_members() & (1u << 10))) return boost::none;
+            PackedReader r = member(11);
+            return read_view(r, PackedType<bool>());
+        }
+
+        boost::optional<bool> get_status_has_changed() const {
+            if (!(present_members() & (1u << 11))) return boost::none;
+            PackedReader r = member(12);
+            return read_view(r, PackedType<bool>());
+        }
+
+        boost::optional<Query> get_query() const {
+            if (!(present_members() & (1u << 12))) return boost::none;
+            PackedReader r = member(13);
+            return read_view(r, PackedType<Query>());
+        }
+    };
+
+    inline void skip_packed(PackedReader & r, PackedType<ElevatorStatusPayload>) {
+        const uint32_t present = r.read_bitmap(13);
+        skip_packed(r, PackedType<MetamodelEnum>());
+        if (!r.ok()) {
+            r.add_error_key("metamodel");
+            return;
+        }
+        if (present & (1u << 0)) {
+            skip_packed(r, PackedType<bool>());
+            if (!r.ok()) {
+                r.add_error_key("admittedRequestFromRobot");
+                return;
+            }
+        }
+        if (present & (1u << 1)) {
+            skip_packed(r, PackedType<int64_t>());
+            if (!r.ok()) {
+                r.add_error_key("calls");
+                return;
+            }
+        }
+        if (present & (1u << 2)) {
+            skip_packed(r, PackedType<bool>());
+            if (!r.ok()) {
+                r.add_error_key("doorOpenAtGoalFloor");
+                return;
+            }
+        }
+        if (present & (1u << 3)) {
+            skip_packed(r, PackedType<bool>());
+            if (!r.ok()) {
+                r.add_error_key("doorOpenAtStartFloor");
+                return;
+            }
+        }
+        if (present & (1u << 4)) {
+            skip_packed(r, PackedType<bool>());
+            if (!r.ok()) {
+                r.add_error_key("doorWaitsForClosingCommand");
+                return;
+            }
+        }
+        if (present & (1u << 5)) {
+            skip_packed(r, PackedType<std::vector<int64_t>>());
+            if (!r.ok()) {
+                r.add_error_key("elevatorIds");
+                return;
+            }
+        }
+        if (present & (1u << 6)) {
+            skip_packed(r, PackedType<int64_t>());
+            if (!r.ok()) {
+                r.add_error_key("floor");
+                return;
+            }
+        }
+        if (present & (1u << 7)) {
+            skip_packed(r, PackedType<int64_t>());
+            if (!r.ok()) {
+                r.add_error_key("id");
+                return;
+            }
+        }
+        if (present & (1u << 8)) {
+            skip_packed(r, PackedType<bool>());
+            if (!r.ok()) {
+                r.add_error_key("isAvailable");
+                return;
+            }
+        }
+        if (present & (1u << 9)) {
+            skip_packed(r, PackedType<Uuid>());
+            if (!r.ok()) {
+                r.add_error_key("queryId");
+                return;
+            }
+        }
+        if (present & (1u << 10)) {
+            skip_packed(r, PackedType<bool>());
+            if (!r.ok()) {
+                r.add_error_key("querySuccess");
+                return;
+            }
+        }
+        if (present & (1u << 11)) {
+            skip_packed(r, PackedType<bool>());
+            if (!r.ok()) {
+                r.add_error_key("statusHasChanged");
+                return;
+            }
+        }
+        if (present & (1u << 12)) {
+            skip_packed(r, PackedType<Query>());
+            if (!r.ok()) {
+                r.add_error_key("query");
+                return;
+            }
         }
     }
-    inline void from_json(const json & j, boost::variant<double, std::string> & x) {
-        if (j.is_number())
-            x = j.get<double>();
-        else if (j.is_string())
-            x = j.get<std::string>();
-        else throw "Could not deserialize";
+
+    inline ElevatorStatusPayloadView read_view(PackedReader & r, PackedType<ElevatorStatusPayload>) {
+        return ElevatorStatusPayloadView(r.current(), r.remaining());
     }
 
-    inline void to_json(json & j, const boost::variant<double, std::string> & x) {
-        switch (x.which()) {
-            case 0:
-                j = boost::get<double>(x);
-                break;
-            case 1:
-                j = boost::get<std::string>(x);
-                break;
-            default: throw "Input JSON does not conform to schema";
+    /**
+     * Read-only view of a packed RopodElevatorStatusSchema; see view_packed.
+     */
+    class RopodElevatorStatusSchemaView {
+        private:
+        const uint8_t * data = nullptr;
+        size_t size = 0;
+
+        PackedReader member(size_t index) const {
+            PackedReader r(data, size);
+            if (index > 0) skip_packed(r, PackedType<Header>());
+            return r;
+        }
+
+        public:
+        RopodElevatorStatusSchemaView() = default;
+        RopodElevatorStatusSchemaView(const uint8_t * data, size_t size) : data(data), size(size) {}
+
+        HeaderView get_header() const {
+            PackedReader r = member(0);
+            return read_view(r, PackedType<Header>());
+        }
+
+        ElevatorStatusPayloadView get_payload() const {
+            PackedReader r = member(1);
+            return read_view(r, PackedType<ElevatorStatusPayload>());
+        }
+    };
+
+    inline void skip_packed(PackedReader & r, PackedType<RopodElevatorStatusSchema>) {
+        skip_packed(r, PackedType<Header>());
+        if (!r.ok()) {
+            r.add_error_key("header");
+            return;
         }
+        skip_packed(r, PackedType<ElevatorStatusPayload>());
+        if (!r.ok()) {
+            r.add_error_key("payload");
+            return;
+        }
+    }
+
+    inline RopodElevatorStatusSchemaView read_view(PackedReader & r, PackedType<RopodElevatorStatusSchema>) {
+        return RopodElevatorStatusSchemaView(r.current(), r.remaining());
+    }
+
+    /**
+     * A Header for a message about to be sent: metamodel set, a fresh msg_id from
+     * Uuid::generate and timestamp stamped, by default with the current time.
+     */
+    inline Header make_header(TypeEnum type, Instant timestamp = Instant::now()) {
+        Header x;
+        x.set_metamodel(MsgMetamodel::ROPOD_MSG_SCHEMA_JSON);
+        x.set_msg_id(Uuid::generate());
+        emplace_optional(x.get_mutable_timestamp()) = timestamp;
+        x.set_type(type);
+        return x;
     }
 }
+}
+
+namespace quicktype {
+    template <>
+    struct PackedSchema<elevator_status::RopodElevatorStatusSchema> {
+        static constexpr uint32_t tag = 8;
+        using View = elevator_status::RopodElevatorStatusSchemaView;
+    };
+}
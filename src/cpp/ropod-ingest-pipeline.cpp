@@ -0,0 +1,446 @@
+//  Ingests ropod messages in stages - frame, parse, validate, dispatch - each on threads of
+//  its own, so that a slow handler holds up only the robots that share its thread:
+//
+//     quicktype::IngestPipeline pipeline;
+//     pipeline.get_dispatcher().on<quicktype::RopodRobotPose2DSchema>([](const quicktype::RopodRobotPose2DSchema & pose) { ... });
+//     pipeline.start();
+//     pipeline.submit(jsonString, robotId);
+//     ...
+//     pipeline.stop();
+//
+//  Messages submitted with the same key, usually the robot id, reach their handler in the
+//  order they were submitted.
+
+#pragma once
+
+#include "ropod-schema-registry.cpp"
+
+namespace quicktype {
+    /**
+     * A bounded lock-free queue for any number of producers and consumers (Vyukov's). Each
+     * cell carries a sequence number that tells producers and consumers whose turn it is, so a
+     * push or a pop is one compare-and-swap and never waits for another thread. With one
+     * producer and one consumer it is an SPSC ring.
+     */
+    template <typename T>
+    class BoundedQueue {
+        private:
+        struct Cell {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+        std::unique_ptr<Cell[]> cells;
+        size_t mask;
+        // head and tail on cache lines of their own, so producers and consumers do not contend
+        char pad_tail[64];
+        std::atomic<size_t> tail{0};
+        char pad_head[64];
+        std::atomic<size_t> head{0};
+        char pad_end[64];
+
+        public:
+        /**
+         * A queue of capacity slots, rounded up to a power of two.
+         */
+        explicit BoundedQueue(size_t capacity) {
+            size_t size = 2;
+            while (size < capacity) size *= 2;
+            cells.reset(new Cell[size]);
+            mask = size - 1;
+            for (size_t i = 0; i < size; i++) cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        BoundedQueue(const BoundedQueue &) = delete;
+        BoundedQueue & operator=(const BoundedQueue &) = delete;
+
+        size_t capacity() const { return mask + 1; }
+
+        /**
+         * Moves value into the queue. Returns false, leaving value as it is, if the queue is
+         * full.
+         */
+        bool try_push(T & value) {
+            size_t position = tail.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell & cell = cells[position & mask];
+                const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+                if (difference == 0) {
+                    if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        cell.value = std::move(value);
+                        cell.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * Moves the oldest value out of the queue. Returns false if the queue is empty.
+         */
+        bool try_pop(T & value) {
+            size_t position = head.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell & cell = cells[position & mask];
+                const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+                if (difference == 0) {
+                    if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        value = std::move(cell.value);
+                        cell.sequence.store(position + mask + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+    };
+
+    /**
+     * The stages of an IngestPipeline, in the order messages pass them. FRAME reads the
+     * header type and drops messages no handler is registered for, PARSE decodes them (which
+     * checks the schemas' constraints), VALIDATE runs the validators registered with
+     * IngestPipeline::validate, DISPATCH calls the handlers.
+     */
+    enum class IngestStage : int { FRAME, PARSE, VALIDATE, DISPATCH };
+
+    constexpr size_t ingest_stage_count = 4;
+
+    constexpr boost::string_view enum_name(IngestStage x) {
+        return x == IngestStage::FRAME ? "frame"
+            : x == IngestStage::PARSE ? "parse"
+            : x == IngestStage::VALIDATE ? "validate"
+            : "dispatch";
+    }
+
+    /**
+     * How a stage runs: the number of threads, each with a queue of its own, the number of
+     * messages a thread takes from its queue at a time, and the capacity of each queue.
+     */
+    class IngestStageOptions {
+        private:
+        size_t threads;
+        size_t batch;
+        size_t capacity;
+
+        public:
+        IngestStageOptions(size_t threads = 1, size_t batch = 32, size_t capacity = 1024)
+            : threads(std::max<size_t>(threads, 1)), batch(std::max<size_t>(batch, 1)), capacity(capacity) {}
+
+        size_t get_threads() const { return threads; }
+        size_t get_batch() const { return batch; }
+        size_t get_capacity() const { return capacity; }
+    };
+
+    /**
+     * Counters of a stage. The depth is the number of messages waiting in the stage's queues;
+     * the latency of a message is the time from entering a queue of the stage to the stage
+     * being done with it, so it includes the wait.
+     */
+    class IngestStageStats {
+        private:
+        size_t depth;
+        uint64_t processed;
+        std::chrono::nanoseconds total_latency;
+        std::chrono::nanoseconds max_latency;
+
+        public:
+        IngestStageStats(size_t depth, uint64_t processed, std::chrono::nanoseconds total_latency, std::chrono::nanoseconds max_latency)
+            : depth(depth), processed(processed), total_latency(total_latency), max_latency(max_latency) {}
+
+        size_t get_depth() const { return depth; }
+        uint64_t get_processed() const { return processed; }
+        std::chrono::nanoseconds get_total_latency() const { return total_latency; }
+        std::chrono::nanoseconds get_max_latency() const { return max_latency; }
+        std::chrono::nanoseconds get_mean_latency() const { return processed == 0 ? std::chrono::nanoseconds(0) : total_latency / static_cast<int64_t>(processed); }
+    };
+
+    /**
+     * A message the pipeline dropped because it did not decode or a validator rejected it, or
+     * whose handler threw, with the stage that dropped it and the key it was submitted with.
+     * For VALIDATE and DISPATCH the error is a CONSTRAINT_VIOLATION with the message of the
+     * exception.
+     */
+    class IngestError {
+        private:
+        IngestStage stage;
+        std::string key;
+        DecodeError error;
+
+        public:
+        IngestError(IngestStage stage, std::string key, DecodeError error) : stage(stage), key(std::move(key)), error(std::move(error)) {}
+
+        IngestStage get_stage() const { return stage; }
+        const std::string & get_key() const { return key; }
+        const DecodeError & get_error() const { return error; }
+    };
+
+    /**
+     * Decodes and dispatches messages on a pipeline of stages connected by bounded lock-free
+     * queues. Every stage has its own threads; a message goes to the thread picked by the hash
+     * of its key at every stage, so messages with the same key stay in order, and a handler
+     * that takes long delays only the keys that hash to its thread. A full queue holds up the
+     * stage in front of it and in the end submit, which bounds the memory in flight.
+     *
+     * Handlers and validators are registered before start() and called on the threads of
+     * their stage: a handler is never called concurrently for one key, but may be for
+     * different keys. A handler that throws does not stop the pipeline: the exception is
+     * passed to the error handler. The error handler is called on the threads of every stage,
+     * possibly from several of them at once, so it must be thread-safe. Idle
+     * threads poll their queue, yielding at first and then sleeping for up to half a
+     * millisecond.
+     */
+    class IngestPipeline {
+        private:
+        struct Item {
+            std::string text;
+            std::string key;
+            uint32_t hash;
+            MessageSchema schema = MessageSchema::MSG;
+            Message message;
+            std::chrono::steady_clock::time_point queued;
+        };
+
+        struct Stage {
+            IngestStageOptions options;
+            std::vector<std::unique_ptr<BoundedQueue<Item *>>> queues;
+            std::vector<std::thread> threads;
+            std::atomic<size_t> running{0};
+            std::atomic<uint64_t> pushed{0};
+            std::atomic<uint64_t> popped{0};
+            std::atomic<uint64_t> processed{0};
+            std::atomic<uint64_t> total_latency{0};
+            std::atomic<uint64_t> max_latency{0};
+        };
+
+        Stage stages[ingest_stage_count];
+        MessageDispatcher dispatcher;
+        std::function<void(const Message &)> validators[message_schema_count];
+        std::function<void(const IngestError &)> error_handler;
+        std::atomic<bool> closed{false};
+        bool started = false;
+
+        static void idle(unsigned & rounds) {
+            if (rounds < 16) std::this_thread::yield();
+            else std::this_thread::sleep_for(std::chrono::microseconds(rounds < 64 ? 50 : 500));
+            if (rounds < 64) rounds++;
+        }
+
+        void push(size_t stage_index, Item * item) {
+            Stage & stage = stages[stage_index];
+            // the high bits of the hash pick the queue, so that keys differing at the end spread
+            const size_t lane = static_cast<size_t>((static_cast<uint64_t>(item->hash) * stage.queues.size()) >> 32);
+            item->queued = std::chrono::steady_clock::now();
+            unsigned rounds = 0;
+            while (!stage.queues[lane]->try_push(item)) idle(rounds);
+            stage.pushed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void fail(Item & item, IngestStage stage, DecodeError error) const {
+            if (error_handler) error_handler(IngestError(stage, item.key, std::move(error)));
+        }
+
+        /**
+         * Runs a stage on one message. Returns false if the message goes no further.
+         */
+        bool process(IngestStage stage, Item & item) const {
+            switch (stage) {
+                case IngestStage::FRAME: {
+                    JsonReader r(item.text.data(), item.text.size());
+                    boost::string_view type;
+                    if (!peek_message_type(r, type)) {
+                        fail(item, stage, r.get_error());
+                        return false;
+                    }
+                    message_schema_from_type(type, item.schema);
+                    return dispatcher.handles(item.schema);
+                }
+                case IngestStage::PARSE: {
+                    JsonReader r(item.text.data(), item.text.size());
+                    read_message(r, item.schema, item.message);
+                    r.finish();
+                    if (!r.ok()) {
+                        fail(item, stage, r.get_error());
+                        return false;
+                    }
+                    std::string().swap(item.text);
+                    return true;
+                }
+                case IngestStage::VALIDATE: {
+                    const std::function<void(const Message &)> & validator = validators[static_cast<int>(item.schema)];
+                    if (!validator) return true;
+                    try {
+                        validator(item.message);
+                    } catch (const std::exception & e) {
+                        fail(item, stage, DecodeError(DecodeErrorKind::CONSTRAINT_VIOLATION, e.what(), "", 0));
+                        return false;
+                    }
+                    return true;
+                }
+                case IngestStage::DISPATCH:
+                    try {
+                        dispatcher.handle(item.message);
+                    } catch (const std::exception & e) {
+                        fail(item, stage, DecodeError(DecodeErrorKind::CONSTRAINT_VIOLATION, e.what(), "", 0));
+                    }
+                    return false;
+            }
+            return false;
+        }
+
+        void work(size_t stage_index, size_t lane) {
+            Stage & stage = stages[stage_index];
+            BoundedQueue<Item *> & queue = *stage.queues[lane];
+            const IngestStage kind = static_cast<IngestStage>(stage_index);
+            const bool last = stage_index + 1 == ingest_stage_count;
+            std::vector<Item *> batch(stage.options.get_batch());
+            std::vector<bool> passed(batch.size());
+            unsigned rounds = 0;
+            for (;;) {
+                // read before popping: once the stage in front has stopped, an empty queue stays empty
+                const bool done = stage_index == 0
+                    ? closed.load(std::memory_order_acquire)
+                    : stages[stage_index - 1].running.load(std::memory_order_acquire) == 0;
+                size_t count = 0;
+                while (count < batch.size() && queue.try_pop(batch[count])) count++;
+                if (count == 0) {
+                    if (done) break;
+                    idle(rounds);
+                    continue;
+                }
+                rounds = 0;
+                stage.popped.fetch_add(count, std::memory_order_relaxed);
+                for (size_t i = 0; i < count; i++) passed[i] = process(kind, *batch[i]);
+
+                const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                uint64_t total = 0;
+                uint64_t highest = 0;
+                for (size_t i = 0; i < count; i++) {
+                    const uint64_t latency = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - batch[i]->queued).count());
+                    total += latency;
+                    highest = std::max(highest, latency);
+                }
+                stage.processed.fetch_add(count, std::memory_order_relaxed);
+                stage.total_latency.fetch_add(total, std::memory_order_relaxed);
+                uint64_t max = stage.max_latency.load(std::memory_order_relaxed);
+                while (highest > max && !stage.max_latency.compare_exchange_weak(max, highest, std::memory_order_relaxed)) {}
+
+                for (size_t i = 0; i < count; i++) {
+                    if (passed[i] && !last) push(stage_index + 1, batch[i]);
+                    else delete batch[i];
+                }
+            }
+            stage.running.fetch_sub(1, std::memory_order_release);
+        }
+
+        public:
+        explicit IngestPipeline(IngestStageOptions frame = IngestStageOptions(), IngestStageOptions parse = IngestStageOptions(),
+                                IngestStageOptions validate = IngestStageOptions(), IngestStageOptions dispatch = IngestStageOptions()) {
+            stages[static_cast<int>(IngestStage::FRAME)].options = frame;
+            stages[static_cast<int>(IngestStage::PARSE)].options = parse;
+            stages[static_cast<int>(IngestStage::VALIDATE)].options = validate;
+            stages[static_cast<int>(IngestStage::DISPATCH)].options = dispatch;
+        }
+
+        IngestPipeline(const IngestPipeline &) = delete;
+        IngestPipeline & operator=(const IngestPipeline &) = delete;
+
+        ~IngestPipeline() { stop(); }
+
+        /**
+         * The dispatcher whose handlers the DISPATCH stage calls. Messages of schemas without
+         * a handler are dropped by the FRAME stage, before they are decoded.
+         */
+        MessageDispatcher & get_dispatcher() { return dispatcher; }
+
+        /**
+         * Registers validator, called with a const T & by the VALIDATE stage for messages of
+         * schema T, replacing the validator registered before. A validator rejects a message by
+         * throwing, for instance the exceptions of CheckConstraint; the message is then passed
+         * to the error handler instead of its handler.
+         */
+        template <typename T, typename Validator>
+        void validate(Validator validator) {
+            validators[static_cast<int>(MessageSchemaOf<T>::value)] = [validator](const Message & message) { validator(boost::get<T>(message)); };
+        }
+
+        /**
+         * Registers the handler of dropped messages, replacing the one registered before. It
+         * may be called concurrently from the threads of several stages.
+         */
+        void on_error(std::function<void(const IngestError &)> handler) { this->error_handler = std::move(handler); }
+
+        bool is_running() const { return started; }
+
+        /**
+         * Starts the threads of every stage, with the stats of every stage reset.
+         */
+        void start() {
+            if (started) return;
+            started = true;
+            closed = false;
+            for (size_t s = 0; s < ingest_stage_count; s++) {
+                Stage & stage = stages[s];
+                const size_t threads = stage.options.get_threads();
+                stage.queues.clear();
+                for (size_t i = 0; i < threads; i++) stage.queues.emplace_back(new BoundedQueue<Item *>(stage.options.get_capacity()));
+                stage.running = threads;
+                stage.pushed = 0;
+                stage.popped = 0;
+                stage.processed = 0;
+                stage.total_latency = 0;
+                stage.max_latency = 0;
+            }
+            for (size_t s = 0; s < ingest_stage_count; s++) {
+                for (size_t i = 0; i < stages[s].options.get_threads(); i++) stages[s].threads.emplace_back([this, s, i] { work(s, i); });
+            }
+        }
+
+        /**
+         * Lets every message submitted so far pass the pipeline and stops the threads. Must not
+         * be called while another thread submits.
+         */
+        void stop() {
+            if (!started) return;
+            closed.store(true, std::memory_order_release);
+            for (Stage & stage : stages) {
+                for (std::thread & thread : stage.threads) thread.join();
+                stage.threads.clear();
+            }
+            started = false;
+        }
+
+        /**
+         * Queues a message received from the robot, or other source, named by key. Waits while
+         * the queue of the FRAME stage is full. Throws std::logic_error if the pipeline is not
+         * running, before start() or after stop().
+         */
+        void submit(std::string text, boost::string_view key) {
+            if (!started) throw std::logic_error("IngestPipeline::submit called while the pipeline is not running");
+            Item * item = new Item;
+            item->text = std::move(text);
+            item->key.assign(key.data(), key.size());
+            item->hash = hash_key(key.data(), key.size());
+            push(static_cast<int>(IngestStage::FRAME), item);
+        }
+
+        IngestStageStats get_stats(IngestStage stage) const {
+            const Stage & s = stages[static_cast<int>(stage)];
+            const uint64_t popped = s.popped.load(std::memory_order_relaxed);
+            const uint64_t pushed = s.pushed.load(std::memory_order_relaxed);
+            return IngestStageStats(
+                static_cast<size_t>(pushed > popped ? pushed - popped : 0),
+                s.processed.load(std::memory_order_relaxed),
+                std::chrono::nanoseconds(s.total_latency.load(std::memory_order_relaxed)),
+                std::chrono::nanoseconds(s.max_latency.load(std::memory_order_relaxed)));
+        }
+    };
+}
@@ -0,0 +1,1552 @@
+//  Generates ropod messages of every schema with random content of a chosen shape, and checks
+//  the constraints of messages, for benchmarks and load tests:
+//
+//     quicktype::MessageShape shape;
+//     shape.set_actions(100);
+//     quicktype::MessageGenerator generator(42, shape);
+//     quicktype::RopodTaskSchema task = generator.generate<quicktype::RopodTaskSchema>();
+//     quicktype::check_constraints(task);
+//
+//  or whole corpora of them:
+//
+//     quicktype::CorpusOptions options;
+//     options.set_actions(quicktype::SizeDistribution(1, 500, quicktype::SizeScale::LOG_UNIFORM));
+//     quicktype::CorpusGenerator corpus(42, options);
+//     corpus.add<quicktype::RopodTaskSchema>();
+//     corpus.write(file, 10000, quicktype::CorpusFormat::NDJSON);
+//
+//  The same seed and shape give the same messages.
+
+#pragma once
+
+#include "ropod-schema-registry.cpp"
+#include "ropod-units-schema.cpp"
+
+namespace quicktype {
+    /**
+     * The shape of the messages a MessageGenerator makes: the number of receiver ids in the
+     * header (none leaves the member out), the number of actions of a task, whether the areas
+     * of task actions carry their debug geometry, whether other optional members are set, the
+     * length of other arrays and maps, how deeply untyped members nest, and the number of
+     * robots the robot ids are drawn from (none makes every id up).
+     */
+    class MessageShape {
+        private:
+        size_t receivers = 2;
+        size_t actions = 4;
+        bool debug_geometry = true;
+        bool optionals = true;
+        size_t list_length = 3;
+        size_t json_depth = 2;
+        size_t robots = 0;
+
+        public:
+        size_t get_receivers() const { return receivers; }
+        void set_receivers(size_t value) { this->receivers = value; }
+
+        size_t get_actions() const { return actions; }
+        void set_actions(size_t value) { this->actions = value; }
+
+        bool get_debug_geometry() const { return debug_geometry; }
+        void set_debug_geometry(bool value) { this->debug_geometry = value; }
+
+        bool get_optionals() const { return optionals; }
+        void set_optionals(bool value) { this->optionals = value; }
+
+        size_t get_list_length() const { return list_length; }
+        void set_list_length(size_t value) { this->list_length = value; }
+
+        size_t get_json_depth() const { return json_depth; }
+        void set_json_depth(size_t value) { this->json_depth = value; }
+
+        size_t get_robots() const { return robots; }
+        void set_robots(size_t value) { this->robots = value; }
+    };
+
+    /**
+     * Makes messages of any schema with random content of a MessageShape. Members are filled
+     * through the visit_members functions below, so every class of every schema is covered:
+     * enums take one of their values, UUIDs are version 4, timestamps fall on 2018-03-21, and
+     * strings with a pattern constraint are drawn from the pattern. Constrained members are
+     * checked with CheckConstraint as they are made, so generated messages always decode.
+     * The actions of a task follow a route through the building: a GOTO, then a ride in an
+     * elevator from the current floor to another, and so on.
+     */
+    class MessageGenerator {
+        private:
+        std::mt19937_64 random;
+        UuidGenerator uuids;
+        MessageShape shape;
+        uint64_t seed;
+        std::vector<Uuid> robot_uuids;
+
+        // 2018-03-21T10:00:00Z
+        static const int64_t first_second = 1521626400;
+
+        size_t length(boost::string_view name) const {
+            if (name == "receiver_ids") return shape.get_receivers();
+            if (name == "actions") return shape.get_actions();
+            return shape.get_list_length();
+        }
+
+        bool is_robot_id(boost::string_view name) const {
+            return shape.get_robots() != 0 && (name == "robot_id" || name == "team_robot_ids" || name == "ropod_id");
+        }
+
+        bool present(boost::string_view name) const {
+            if (name == "payload") return true;
+            if (name == "receiver_ids") return shape.get_receivers() != 0;
+            if (name.starts_with("debug_")) return shape.get_debug_geometry();
+            return shape.get_optionals();
+        }
+
+        json make_json(size_t depth) {
+            if (depth == 0) {
+                switch (random() % 3) {
+                    case 0: return json(static_cast<double>(random() % 100000) / 100);
+                    case 1: return json((random() & 1) != 0);
+                    default: return json("value_" + std::to_string(random() % 1000));
+                }
+            }
+            json object = json::object();
+            for (size_t i = 0; i < shape.get_list_length(); i++) object["key_" + std::to_string(i)] = make_json(depth - 1);
+            return object;
+        }
+
+        void constrain(boost::string_view name, std::string & x, const ClassMemberConstraints & c) {
+            if (c.get_pattern_matcher() != nullptr) c.get_pattern_matcher()->sample(random, x);
+            if (c.get_min_length() != boost::none && x.length() < *c.get_min_length()) x.resize(*c.get_min_length(), 'x');
+            if (c.get_max_length() != boost::none && x.length() > *c.get_max_length()) x.resize(*c.get_max_length());
+            CheckConstraint(name.to_string(), c, x);
+        }
+
+        void constrain(boost::string_view name, int64_t & x, const ClassMemberConstraints & c) {
+            if (c.get_min_value() != boost::none && x < *c.get_min_value()) x = *c.get_min_value();
+            if (c.get_max_value() != boost::none && x > *c.get_max_value()) x = *c.get_max_value();
+            CheckConstraint(name.to_string(), c, x);
+        }
+
+        template <typename T>
+        void constrain(boost::string_view name, std::shared_ptr<T> & x, const ClassMemberConstraints & c) {
+            if (x) constrain(name, *x, c);
+        }
+
+        template <typename T>
+        void constrain(boost::string_view name, boost::optional<T> & x, const ClassMemberConstraints & c) {
+            if (x) constrain(name, *x, c);
+        }
+
+        // UUIDs always match the UUID pattern
+        void constrain(boost::string_view, Uuid &, const ClassMemberConstraints &) {}
+
+        public:
+        // the ids draw from a seed of their own, so they do not follow the random content
+        explicit MessageGenerator(uint64_t seed = 0, MessageShape shape = MessageShape())
+            : random(seed), uuids(seed + 0x9E3779B97F4A7C15u), shape(shape), seed(seed) {}
+
+        const MessageShape & get_shape() const { return shape; }
+        void set_shape(const MessageShape & value) { this->shape = value; }
+
+        template <typename T>
+        T generate() {
+            T x;
+            value(boost::string_view(), x);
+            return x;
+        }
+
+        template <typename T>
+        void generate(T & x) { value(boost::string_view(), x); }
+
+        /**
+         * Called by visit_members with each member of a class and, if it has any, its
+         * constraints.
+         */
+        template <typename T>
+        void member(boost::string_view name, T & x) { value(name, x); }
+
+        template <typename T>
+        void member(boost::string_view name, T & x, const ClassMemberConstraints & c) {
+            value(name, x);
+            constrain(name, x, c);
+        }
+
+        void value(boost::string_view, bool & x) { x = (random() & 1) != 0; }
+        void value(boost::string_view, int64_t & x) { x = static_cast<int64_t>(random() % 100); }
+        void value(boost::string_view, double & x) { x = static_cast<double>(static_cast<int64_t>(random() % 200000) - 100000) / 1000; }
+        void value(boost::string_view name, std::string & x) {
+            if (is_robot_id(name)) x = "ropod_" + std::to_string(random() % shape.get_robots());
+            else x = name.to_string() + "_" + std::to_string(random() % 1000);
+        }
+
+        void value(boost::string_view name, Uuid & x) {
+            if (!is_robot_id(name)) {
+                x = uuids.next();
+                return;
+            }
+            // the same robots for every message of a seed
+            if (robot_uuids.size() != shape.get_robots()) {
+                UuidGenerator robot_generator(~seed);
+                robot_uuids.resize(shape.get_robots());
+                for (Uuid & robot : robot_uuids) robot = robot_generator.next();
+            }
+            x = robot_uuids[random() % robot_uuids.size()];
+        }
+
+        void value(boost::string_view, Instant & x) { x = Instant((first_second + static_cast<int64_t>(random() % 86400)) * 1000000000 + static_cast<int64_t>(random() % 1000) * 1000000); }
+        void value(boost::string_view, json & x) { x = make_json(shape.get_json_depth()); }
+
+        template <typename T>
+        typename std::enable_if<std::is_enum<T>::value>::type value(boost::string_view, T & x) {
+            // enum_name is empty past the last value
+            static const int count = [] {
+                int n = 0;
+                while (!enum_name(static_cast<T>(n)).empty()) n++;
+                return n;
+            }();
+            x = static_cast<T>(random() % static_cast<uint64_t>(count));
+        }
+
+        template <typename T>
+        typename std::enable_if<std::is_class<T>::value>::type value(boost::string_view, T & x) { visit_members(*this, x); }
+
+        template <typename T>
+        void value(boost::string_view name, std::vector<T> & x) {
+            x.resize(length(name));
+            for (T & element : x) value(name, element);
+        }
+
+        void value(boost::string_view name, std::vector<task::Action> & x) {
+            static const task::ActionType route[] = { task::ActionType::GOTO, task::ActionType::REQUEST_ELEVATOR, task::ActionType::ENTER_ELEVATOR, task::ActionType::EXIT_ELEVATOR };
+            x.resize(length(name));
+            double floor = static_cast<double>(random() % 10);
+            double goal_floor = floor;
+            Uuid elevator;
+            for (size_t i = 0; i < x.size(); i++) {
+                task::Action & action = x[i];
+                value(name, action);
+                const task::ActionType type = route[i % 4];
+                action.set_action_type(type);
+                if (type == task::ActionType::REQUEST_ELEVATOR) {
+                    elevator = uuids.next();
+                    goal_floor = static_cast<double>((static_cast<uint64_t>(floor) + 1 + random() % 9) % 10);
+                }
+                if (!shape.get_optionals()) continue;
+                if (type == task::ActionType::GOTO) {
+                    action.get_mutable_elevator_id() = {};
+                    action.get_mutable_start_floor() = {};
+                    action.get_mutable_goal_floor() = {};
+                    emplace_optional(action.get_mutable_level()) = floor;
+                    continue;
+                }
+                emplace_optional(action.get_mutable_elevator_id()) = elevator;
+                emplace_optional(action.get_mutable_start_floor()) = floor;
+                emplace_optional(action.get_mutable_goal_floor()) = goal_floor;
+                emplace_optional(action.get_mutable_level()) = type == task::ActionType::EXIT_ELEVATOR ? goal_floor : floor;
+                if (type == task::ActionType::EXIT_ELEVATOR) floor = goal_floor;
+            }
+        }
+
+        template <typename T>
+        void value(boost::string_view name, std::map<std::string, T> & x) {
+            x.clear();
+            for (size_t i = 0; i < length(name); i++) value(name, x[name.to_string() + "_" + std::to_string(i)]);
+        }
+
+        template <typename T>
+        void value(boost::string_view name, std::shared_ptr<T> & x) {
+            if (present(name)) value(name, emplace_optional(x));
+            else x = {};
+        }
+
+        template <typename T>
+        void value(boost::string_view name, boost::optional<T> & x) {
+            if (present(name)) value(name, emplace_optional(x));
+            else x = {};
+        }
+    };
+
+    /**
+     * Checks each constrained member of a message with CheckConstraint, as the setters do.
+     */
+    class ConstraintChecker {
+        private:
+        void check(boost::string_view name, const std::string & x, const ClassMemberConstraints & c) { CheckConstraint(name.to_string(), c, x); }
+        void check(boost::string_view name, int64_t x, const ClassMemberConstraints & c) { CheckConstraint(name.to_string(), c, x); }
+        void check(boost::string_view name, const Uuid & x, const ClassMemberConstraints & c) { CheckConstraint(name.to_string(), c, x.to_string()); }
+
+        template <typename T>
+        void check(boost::string_view name, const std::shared_ptr<T> & x, const ClassMemberConstraints & c) {
+            if (x) check(name, *x, c);
+        }
+
+        template <typename T>
+        void check(boost::string_view name, const boost::optional<T> & x, const ClassMemberConstraints & c) {
+            if (x) check(name, *x, c);
+        }
+
+        public:
+        template <typename T>
+        void member(boost::string_view, const T & x) { value(x); }
+
+        template <typename T>
+        void member(boost::string_view name, const T & x, const ClassMemberConstraints & c) { check(name, x, c); }
+
+        void value(const std::string &) {}
+        void value(const json &) {}
+        void value(const Uuid &) {}
+        void value(const Instant &) {}
+
+        template <typename T>
+        typename std::enable_if<!std::is_class<T>::value>::type value(const T &) {}
+
+        template <typename T>
+        typename std::enable_if<std::is_class<T>::value>::type value(const T & x) { visit_members(*this, x); }
+
+        template <typename T>
+        void value(const std::vector<T> & x) {
+            for (const T & element : x) value(element);
+        }
+
+        template <typename T>
+        void value(const std::map<std::string, T> & x) {
+            for (const auto & member : x) value(member.second);
+        }
+
+        template <typename T>
+        void value(const std::shared_ptr<T> & x) {
+            if (x) value(*x);
+        }
+
+        template <typename T>
+        void value(const boost::optional<T> & x) {
+            if (x) value(*x);
+        }
+    };
+
+    /**
+     * Throws the exception of the first CheckConstraint rule x breaks, like setting the
+     * member through its setter would.
+     */
+    template <typename T>
+    inline void check_constraints(const T & x) {
+        ConstraintChecker checker;
+        checker.value(x);
+    }
+
+    /**
+     * How a corpus is stored: NDJSON, one message per line as encode writes it, or PACKED, each
+     * message in the packed format of encode_packed after its length as 4 little-endian bytes.
+     */
+    enum class CorpusFormat : int { NDJSON, PACKED };
+
+    /**
+     * How sizes between a minimum and a maximum are drawn: all equally likely, or with every
+     * order of magnitude equally likely, which makes small sizes common and large ones rare.
+     */
+    enum class SizeScale : int { UNIFORM, LOG_UNIFORM };
+
+    class SizeDistribution {
+        private:
+        size_t min;
+        size_t max;
+        SizeScale scale;
+
+        public:
+        SizeDistribution(size_t value = 0) : min(value), max(value), scale(SizeScale::UNIFORM) {}
+        SizeDistribution(size_t min, size_t max, SizeScale scale = SizeScale::UNIFORM)
+            : min(std::min(min, max)), max(std::max(min, max)), scale(scale) {}
+
+        size_t get_min() const { return min; }
+        size_t get_max() const { return max; }
+        SizeScale get_scale() const { return scale; }
+
+        template <typename Random>
+        size_t sample(Random & random) const {
+            if (min == max) return min;
+            if (scale == SizeScale::UNIFORM) return min + static_cast<size_t>(random() % (max - min + 1));
+            // log-uniform over [min + 1, max + 2), shifted back by one so that a minimum of 0 works
+            const double low = std::log(static_cast<double>(min) + 1);
+            const double high = std::log(static_cast<double>(max) + 2);
+            const double unit = static_cast<double>(random() >> 11) / 9007199254740992.0;
+            const size_t value = static_cast<size_t>(std::exp(low + unit * (high - low))) - 1;
+            return std::min(std::max(value, min), max);
+        }
+    };
+
+    /**
+     * The shapes of the messages of a corpus. Each message draws the sizes of its MessageShape
+     * from these distributions, sets its optional members and the debug geometry of its task
+     * actions with the given probabilities, and draws its robot ids from a fleet of the given
+     * number of robots.
+     */
+    class CorpusOptions {
+        private:
+        SizeDistribution receivers = 2;
+        SizeDistribution actions = 4;
+        SizeDistribution list_length = 3;
+        SizeDistribution json_depth = 2;
+        double optionals = 1;
+        double debug_geometry = 1;
+        size_t robots = 0;
+
+        public:
+        const SizeDistribution & get_receivers() const { return receivers; }
+        void set_receivers(const SizeDistribution & value) { this->receivers = value; }
+
+        const SizeDistribution & get_actions() const { return actions; }
+        void set_actions(const SizeDistribution & value) { this->actions = value; }
+
+        const SizeDistribution & get_list_length() const { return list_length; }
+        void set_list_length(const SizeDistribution & value) { this->list_length = value; }
+
+        const SizeDistribution & get_json_depth() const { return json_depth; }
+        void set_json_depth(const SizeDistribution & value) { this->json_depth = value; }
+
+        double get_optionals() const { return optionals; }
+        void set_optionals(double value) { this->optionals = value; }
+
+        double get_debug_geometry() const { return debug_geometry; }
+        void set_debug_geometry(double value) { this->debug_geometry = value; }
+
+        size_t get_robots() const { return robots; }
+        void set_robots(size_t value) { this->robots = value; }
+    };
+
+    /**
+     * Writes corpora of generated messages for load and regression tests. Each message is of
+     * a root class picked by the weights given to add, has a shape drawn from the
+     * CorpusOptions, and is checked with check_constraints before it is written, so every
+     * message of a corpus passes the CheckConstraint rules. The same seed, options and root
+     * classes give the same corpus.
+     */
+    class CorpusGenerator {
+        private:
+        using Writer = void (*)(MessageGenerator &, CorpusFormat, std::string &);
+
+        std::mt19937_64 random;
+        MessageGenerator generator;
+        CorpusOptions options;
+        std::vector<std::pair<double, Writer>> roots;
+        double total_weight = 0;
+
+        template <typename T>
+        static void write_message(MessageGenerator & generator, CorpusFormat format, std::string & out) {
+            const T x = generator.generate<T>();
+            check_constraints(x);
+            if (format == CorpusFormat::NDJSON) {
+                out += encode(x);
+                out += '\n';
+                return;
+            }
+            const std::vector<uint8_t> bytes = encode_packed(x);
+            const uint32_t size = static_cast<uint32_t>(bytes.size());
+            for (int i = 0; i < 4; i++) out += static_cast<char>(size >> (8 * i) & 0xFF);
+            out.append(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+        }
+
+        double unit() { return static_cast<double>(random() >> 11) / 9007199254740992.0; }
+
+        MessageShape next_shape() {
+            MessageShape shape;
+            shape.set_receivers(options.get_receivers().sample(random));
+            shape.set_actions(options.get_actions().sample(random));
+            shape.set_list_length(options.get_list_length().sample(random));
+            shape.set_json_depth(options.get_json_depth().sample(random));
+            shape.set_optionals(unit() < options.get_optionals());
+            shape.set_debug_geometry(unit() < options.get_debug_geometry());
+            shape.set_robots(options.get_robots());
+            return shape;
+        }
+
+        public:
+        explicit CorpusGenerator(uint64_t seed = 0, CorpusOptions options = CorpusOptions())
+            : random(seed + 0x9E3779B97F4A7C15u), generator(seed), options(options) {}
+
+        const CorpusOptions & get_options() const { return options; }
+        void set_options(const CorpusOptions & value) { this->options = value; }
+
+        /**
+         * Adds T to the root classes of the corpus, picked for a message with probability
+         * weight over the sum of the weights.
+         */
+        template <typename T>
+        void add(double weight = 1) {
+            roots.emplace_back(weight, &write_message<T>);
+            total_weight += weight;
+        }
+
+        /**
+         * Appends the next message to out. Throws std::logic_error if no root class was added.
+         */
+        void next(CorpusFormat format, std::string & out) {
+            if (roots.empty()) throw std::logic_error("CorpusGenerator has no root classes");
+            double pick = unit() * total_weight;
+            size_t root = 0;
+            while (root + 1 < roots.size() && pick >= roots[root].first) pick -= roots[root++].first;
+            generator.set_shape(next_shape());
+            roots[root].second(generator, format, out);
+        }
+
+        /**
+         * Writes count messages to out and returns the number of bytes written.
+         */
+        size_t write(std::ostream & out, size_t count, CorpusFormat format) {
+            std::string record;
+            size_t bytes = 0;
+            for (size_t i = 0; i < count; i++) {
+                record.clear();
+                next(format, record);
+                out.write(record.data(), static_cast<std::streamsize>(record.size()));
+                bytes += record.size();
+            }
+            return bytes;
+        }
+    };
+
+    /**
+     * Reads the messages of a corpus held in memory, one at a time: JSON text for NDJSON,
+     * packed bytes for PACKED.
+     */
+    class CorpusReader {
+        private:
+        const char * cur;
+        const char * end;
+        CorpusFormat format;
+
+        public:
+        CorpusReader(const char * data, size_t size, CorpusFormat format) : cur(data), end(data + size), format(format) {}
+
+        /**
+         * Sets message to the next message. Returns false at the end of the corpus or if the
+         * last record is cut short.
+         */
+        bool next(boost::string_view & message) {
+            if (format == CorpusFormat::NDJSON) {
+                while (cur < end && *cur == '\n') cur++;
+                if (cur == end) return false;
+                const char * line_end = static_cast<const char *>(std::memchr(cur, '\n', static_cast<size_t>(end - cur)));
+                if (line_end == nullptr) line_end = end;
+                message = boost::string_view(cur, static_cast<size_t>(line_end - cur));
+                cur = line_end;
+                return true;
+            }
+            if (end - cur < 4) return false;
+            uint32_t size = 0;
+            for (int i = 0; i < 4; i++) size |= static_cast<uint32_t>(static_cast<uint8_t>(cur[i])) << (8 * i);
+            if (static_cast<size_t>(end - cur - 4) < size) return false;
+            message = boost::string_view(cur + 4, size);
+            cur += 4 + size;
+            return true;
+        }
+    };
+}
+
+//  visit_members(visitor, x) calls visitor.member(name, member) for each member of x, with the
+//  constraints of the member if it has any. MessageGenerator and ConstraintChecker walk
+//  messages with it.
+
+namespace quicktype {
+namespace black_box_data_query {
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Header & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("msg_id", x.get_mutable_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_mutable_receiver_ids());
+        v.member("timestamp", x.get_mutable_timestamp());
+        v.member("type", x.get_mutable_type());
+        v.member("version", x.get_mutable_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Header & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("msg_id", x.get_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_receiver_ids());
+        v.member("timestamp", x.get_timestamp());
+        v.member("type", x.get_type());
+        v.member("version", x.get_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Payload & x) {
+        v.member("black_box_id", x.get_mutable_black_box_id());
+        v.member("end_time", x.get_mutable_end_time());
+        v.member("sender_id", x.get_mutable_sender_id());
+        v.member("start_time", x.get_mutable_start_time());
+        v.member("variables", x.get_mutable_variables());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Payload & x) {
+        v.member("black_box_id", x.get_black_box_id());
+        v.member("end_time", x.get_end_time());
+        v.member("sender_id", x.get_sender_id());
+        v.member("start_time", x.get_start_time());
+        v.member("variables", x.get_variables());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, RopodBlackBoxDataQuerySchema & x) {
+        v.member("header", x.get_mutable_header());
+        v.member("payload", x.get_mutable_payload());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const RopodBlackBoxDataQuerySchema & x) {
+        v.member("header", x.get_header());
+        v.member("payload", x.get_payload());
+    }
+}
+}
+
+namespace quicktype {
+namespace black_box_latest_data_query {
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Header & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("msg_id", x.get_mutable_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_mutable_receiver_ids());
+        v.member("timestamp", x.get_mutable_timestamp());
+        v.member("type", x.get_mutable_type());
+        v.member("version", x.get_mutable_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Header & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("msg_id", x.get_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_receiver_ids());
+        v.member("timestamp", x.get_timestamp());
+        v.member("type", x.get_type());
+        v.member("version", x.get_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Payload & x) {
+        v.member("black_box_id", x.get_mutable_black_box_id());
+        v.member("sender_id", x.get_mutable_sender_id());
+        v.member("variables", x.get_mutable_variables());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Payload & x) {
+        v.member("black_box_id", x.get_black_box_id());
+        v.member("sender_id", x.get_sender_id());
+        v.member("variables", x.get_variables());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, RopodBlackBoxLatestDataQuerySchema & x) {
+        v.member("header", x.get_mutable_header());
+        v.member("payload", x.get_mutable_payload());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const RopodBlackBoxLatestDataQuerySchema & x) {
+        v.member("header", x.get_header());
+        v.member("payload", x.get_payload());
+    }
+}
+}
+
+namespace quicktype {
+namespace black_box_logging_cmd {
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Header & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("msg_id", x.get_mutable_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_mutable_receiver_ids());
+        v.member("timestamp", x.get_mutable_timestamp());
+        v.member("type", x.get_mutable_type());
+        v.member("version", x.get_mutable_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Header & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("msg_id", x.get_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_receiver_ids());
+        v.member("timestamp", x.get_timestamp());
+        v.member("type", x.get_type());
+        v.member("version", x.get_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Payload & x) {
+        v.member("cmd", x.get_mutable_cmd());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Payload & x) {
+        v.member("cmd", x.get_cmd());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, RopodBlackBoxLoggingCmdSchema & x) {
+        v.member("header", x.get_mutable_header());
+        v.member("payload", x.get_mutable_payload());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const RopodBlackBoxLoggingCmdSchema & x) {
+        v.member("header", x.get_header());
+        v.member("payload", x.get_payload());
+    }
+}
+}
+
+namespace quicktype {
+namespace black_box_variable_query {
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Header & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("msg_id", x.get_mutable_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_mutable_receiver_ids());
+        v.member("timestamp", x.get_mutable_timestamp());
+        v.member("type", x.get_mutable_type());
+        v.member("version", x.get_mutable_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Header & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("msg_id", x.get_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_receiver_ids());
+        v.member("timestamp", x.get_timestamp());
+        v.member("type", x.get_type());
+        v.member("version", x.get_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Payload & x) {
+        v.member("black_box_id", x.get_mutable_black_box_id());
+        v.member("sender_id", x.get_mutable_sender_id());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Payload & x) {
+        v.member("black_box_id", x.get_black_box_id());
+        v.member("sender_id", x.get_sender_id());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, RopodBlackBoxVariableQuerySchema & x) {
+        v.member("header", x.get_mutable_header());
+        v.member("payload", x.get_mutable_payload());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const RopodBlackBoxVariableQuerySchema & x) {
+        v.member("header", x.get_header());
+        v.member("payload", x.get_payload());
+    }
+}
+}
+
+namespace quicktype {
+namespace cmd {
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Header & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("msg_id", x.get_mutable_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_mutable_receiver_ids());
+        v.member("timestamp", x.get_mutable_timestamp());
+        v.member("type", x.get_mutable_type());
+        v.member("version", x.get_mutable_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Header & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("msg_id", x.get_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_receiver_ids());
+        v.member("timestamp", x.get_timestamp());
+        v.member("type", x.get_type());
+        v.member("version", x.get_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Payload & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("command", x.get_mutable_command());
+        v.member("id", x.get_mutable_id(), Payload::get_id_constraint());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Payload & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("command", x.get_command());
+        v.member("id", x.get_id(), Payload::get_id_constraint());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, RopodCmdSchema & x) {
+        v.member("header", x.get_mutable_header());
+        v.member("payload", x.get_mutable_payload());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const RopodCmdSchema & x) {
+        v.member("header", x.get_header());
+        v.member("payload", x.get_payload());
+    }
+}
+}
+
+namespace quicktype {
+namespace component_monitor {
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Header & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("msg_id", x.get_mutable_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_mutable_receiver_ids());
+        v.member("timestamp", x.get_mutable_timestamp());
+        v.member("type", x.get_mutable_type());
+        v.member("version", x.get_mutable_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Header & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("msg_id", x.get_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_receiver_ids());
+        v.member("timestamp", x.get_timestamp());
+        v.member("type", x.get_type());
+        v.member("version", x.get_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Mode & x) {
+        v.member("health_status", x.get_mutable_health_status());
+        v.member("monitor_description", x.get_mutable_monitor_description());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Mode & x) {
+        v.member("health_status", x.get_health_status());
+        v.member("monitor_description", x.get_monitor_description());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Monitor & x) {
+        v.member("component", x.get_mutable_component());
+        v.member("modes", x.get_mutable_modes());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Monitor & x) {
+        v.member("component", x.get_component());
+        v.member("modes", x.get_modes());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Payload & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("monitors", x.get_mutable_monitors());
+        v.member("ropod_id", x.get_mutable_ropod_id(), Payload::get_ropod_id_constraint());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Payload & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("monitors", x.get_monitors());
+        v.member("ropod_id", x.get_ropod_id(), Payload::get_ropod_id_constraint());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, RopodComponentMonitorSchema & x) {
+        v.member("header", x.get_mutable_header());
+        v.member("payload", x.get_mutable_payload());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const RopodComponentMonitorSchema & x) {
+        v.member("header", x.get_header());
+        v.member("payload", x.get_payload());
+    }
+}
+}
+
+namespace quicktype {
+namespace elevator_cmd {
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Header & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("msg_id", x.get_mutable_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_mutable_receiver_ids());
+        v.member("timestamp", x.get_mutable_timestamp());
+        v.member("type", x.get_mutable_type());
+        v.member("version", x.get_mutable_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Header & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("msg_id", x.get_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_receiver_ids());
+        v.member("timestamp", x.get_timestamp());
+        v.member("type", x.get_type());
+        v.member("version", x.get_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, ElevatorPayload & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("command", x.get_mutable_command());
+        v.member("elevator_id", x.get_mutable_elevator_id());
+        v.member("goal_floor", x.get_mutable_goal_floor());
+        v.member("operational_mode", x.get_mutable_operational_mode());
+        v.member("query_id", x.get_mutable_query_id(), ElevatorPayload::get_query_id_constraint());
+        v.member("start_floor", x.get_mutable_start_floor());
+        v.member("error_message", x.get_mutable_error_message());
+        v.member("query_success", x.get_mutable_query_success());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const ElevatorPayload & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("command", x.get_command());
+        v.member("elevator_id", x.get_elevator_id());
+        v.member("goal_floor", x.get_goal_floor());
+        v.member("operational_mode", x.get_operational_mode());
+        v.member("query_id", x.get_query_id(), ElevatorPayload::get_query_id_constraint());
+        v.member("start_floor", x.get_start_floor());
+        v.member("error_message", x.get_error_message());
+        v.member("query_success", x.get_query_success());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, RopodElevatorCmdSchema & x) {
+        v.member("header", x.get_mutable_header());
+        v.member("payload", x.get_mutable_payload());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const RopodElevatorCmdSchema & x) {
+        v.member("header", x.get_header());
+        v.member("payload", x.get_payload());
+    }
+}
+}
+
+namespace quicktype {
+namespace elevator_status {
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Header & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("msg_id", x.get_mutable_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_mutable_receiver_ids());
+        v.member("timestamp", x.get_mutable_timestamp());
+        v.member("type", x.get_mutable_type());
+        v.member("version", x.get_mutable_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Header & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("msg_id", x.get_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_receiver_ids());
+        v.member("timestamp", x.get_timestamp());
+        v.member("type", x.get_type());
+        v.member("version", x.get_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, ElevatorStatusPayload & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("admitted_request_from_robot", x.get_mutable_admitted_request_from_robot());
+        v.member("calls", x.get_mutable_calls());
+        v.member("door_open_at_goal_floor", x.get_mutable_door_open_at_goal_floor());
+        v.member("door_open_at_start_floor", x.get_mutable_door_open_at_start_floor());
+        v.member("door_waits_for_closing_command", x.get_mutable_door_waits_for_closing_command());
+        v.member("elevator_ids", x.get_mutable_elevator_ids());
+        v.member("floor", x.get_mutable_floor());
+        v.member("id", x.get_mutable_id());
+        v.member("is_available", x.get_mutable_is_available());
+        v.member("query_id", x.get_mutable_query_id(), ElevatorStatusPayload::get_query_id_constraint());
+        v.member("query_success", x.get_mutable_query_success());
+        v.member("status_has_changed", x.get_mutable_status_has_changed());
+        v.member("query", x.get_mutable_query());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const ElevatorStatusPayload & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("admitted_request_from_robot", x.get_admitted_request_from_robot());
+        v.member("calls", x.get_calls());
+        v.member("door_open_at_goal_floor", x.get_door_open_at_goal_floor());
+        v.member("door_open_at_start_floor", x.get_door_open_at_start_floor());
+        v.member("door_waits_for_closing_command", x.get_door_waits_for_closing_command());
+        v.member("elevator_ids", x.get_elevator_ids());
+        v.member("floor", x.get_floor());
+        v.member("id", x.get_id());
+        v.member("is_available", x.get_is_available());
+        v.member("query_id", x.get_query_id(), ElevatorStatusPayload::get_query_id_constraint());
+        v.member("query_success", x.get_query_success());
+        v.member("status_has_changed", x.get_status_has_changed());
+        v.member("query", x.get_query());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, RopodElevatorStatusSchema & x) {
+        v.member("header", x.get_mutable_header());
+        v.member("payload", x.get_mutable_payload());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const RopodElevatorStatusSchema & x) {
+        v.member("header", x.get_header());
+        v.member("payload", x.get_payload());
+    }
+}
+}
+
+namespace quicktype {
+namespace experiment_cancel {
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Header & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("msg_id", x.get_mutable_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_mutable_receiver_ids());
+        v.member("timestamp", x.get_mutable_timestamp());
+        v.member("type", x.get_mutable_type());
+        v.member("version", x.get_mutable_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Header & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("msg_id", x.get_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_receiver_ids());
+        v.member("timestamp", x.get_timestamp());
+        v.member("type", x.get_type());
+        v.member("version", x.get_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Payload & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Payload & x) {
+        v.member("metamodel", x.get_metamodel());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, RopodExperimentCancel & x) {
+        v.member("header", x.get_mutable_header());
+        v.member("payload", x.get_mutable_payload());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const RopodExperimentCancel & x) {
+        v.member("header", x.get_header());
+        v.member("payload", x.get_payload());
+    }
+}
+}
+
+namespace quicktype {
+namespace experiment_request {
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Header & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("msg_id", x.get_mutable_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_mutable_receiver_ids());
+        v.member("timestamp", x.get_mutable_timestamp());
+        v.member("type", x.get_mutable_type());
+        v.member("version", x.get_mutable_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Header & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("msg_id", x.get_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_receiver_ids());
+        v.member("timestamp", x.get_timestamp());
+        v.member("type", x.get_type());
+        v.member("version", x.get_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Payload & x) {
+        v.member("experiment_type", x.get_mutable_experiment_type());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Payload & x) {
+        v.member("experiment_type", x.get_experiment_type());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, RopodExperimentRequest & x) {
+        v.member("header", x.get_mutable_header());
+        v.member("payload", x.get_mutable_payload());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const RopodExperimentRequest & x) {
+        v.member("header", x.get_header());
+        v.member("payload", x.get_payload());
+    }
+}
+}
+
+namespace quicktype {
+namespace experiment_sm {
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Header & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("msg_id", x.get_mutable_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_mutable_receiver_ids());
+        v.member("timestamp", x.get_mutable_timestamp());
+        v.member("type", x.get_mutable_type());
+        v.member("version", x.get_mutable_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Header & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("msg_id", x.get_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_receiver_ids());
+        v.member("timestamp", x.get_timestamp());
+        v.member("type", x.get_type());
+        v.member("version", x.get_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Payload & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("robot_id", x.get_mutable_robot_id());
+        v.member("transitions", x.get_mutable_transitions());
+        v.member("user_id", x.get_mutable_user_id());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Payload & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("robot_id", x.get_robot_id());
+        v.member("transitions", x.get_transitions());
+        v.member("user_id", x.get_user_id());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, RopodExperimentSmSchema & x) {
+        v.member("header", x.get_mutable_header());
+        v.member("payload", x.get_mutable_payload());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const RopodExperimentSmSchema & x) {
+        v.member("header", x.get_header());
+        v.member("payload", x.get_payload());
+    }
+}
+}
+
+namespace quicktype {
+namespace fms_elevator {
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Header & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("msg_id", x.get_mutable_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_mutable_receiver_ids());
+        v.member("timestamp", x.get_mutable_timestamp());
+        v.member("type", x.get_mutable_type());
+        v.member("version", x.get_mutable_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Header & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("msg_id", x.get_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_receiver_ids());
+        v.member("timestamp", x.get_timestamp());
+        v.member("type", x.get_type());
+        v.member("version", x.get_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, FmsElevatorPayload & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("call_id", x.get_mutable_call_id(), FmsElevatorPayload::get_call_id_constraint());
+        v.member("command", x.get_mutable_command());
+        v.member("goal_floor", x.get_mutable_goal_floor());
+        v.member("load", x.get_mutable_load());
+        v.member("query_id", x.get_mutable_query_id(), FmsElevatorPayload::get_query_id_constraint());
+        v.member("robot_id", x.get_mutable_robot_id());
+        v.member("start_floor", x.get_mutable_start_floor());
+        v.member("task_id", x.get_mutable_task_id(), FmsElevatorPayload::get_task_id_constraint());
+        v.member("elevator_door_id", x.get_mutable_elevator_door_id());
+        v.member("elevator_id", x.get_mutable_elevator_id());
+        v.member("query_success", x.get_mutable_query_success());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const FmsElevatorPayload & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("call_id", x.get_call_id(), FmsElevatorPayload::get_call_id_constraint());
+        v.member("command", x.get_command());
+        v.member("goal_floor", x.get_goal_floor());
+        v.member("load", x.get_load());
+        v.member("query_id", x.get_query_id(), FmsElevatorPayload::get_query_id_constraint());
+        v.member("robot_id", x.get_robot_id());
+        v.member("start_floor", x.get_start_floor());
+        v.member("task_id", x.get_task_id(), FmsElevatorPayload::get_task_id_constraint());
+        v.member("elevator_door_id", x.get_elevator_door_id());
+        v.member("elevator_id", x.get_elevator_id());
+        v.member("query_success", x.get_query_success());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, RopodFmsElevatorSchema & x) {
+        v.member("header", x.get_mutable_header());
+        v.member("payload", x.get_mutable_payload());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const RopodFmsElevatorSchema & x) {
+        v.member("header", x.get_header());
+        v.member("payload", x.get_payload());
+    }
+}
+}
+
+namespace quicktype {
+namespace msg {
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Header & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("msg_id", x.get_mutable_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_mutable_receiver_ids());
+        v.member("timestamp", x.get_mutable_timestamp());
+        v.member("type", x.get_mutable_type());
+        v.member("version", x.get_mutable_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Header & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("msg_id", x.get_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_receiver_ids());
+        v.member("timestamp", x.get_timestamp());
+        v.member("type", x.get_type());
+        v.member("version", x.get_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Payload & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Payload & x) {
+        v.member("metamodel", x.get_metamodel());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, RopodMsgSchema & x) {
+        v.member("header", x.get_mutable_header());
+        v.member("payload", x.get_mutable_payload());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const RopodMsgSchema & x) {
+        v.member("header", x.get_header());
+        v.member("payload", x.get_payload());
+    }
+}
+}
+
+namespace quicktype {
+namespace robot_pose_2d {
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Header & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("msg_id", x.get_mutable_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_mutable_receiver_ids());
+        v.member("timestamp", x.get_mutable_timestamp());
+        v.member("type", x.get_mutable_type());
+        v.member("version", x.get_mutable_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Header & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("msg_id", x.get_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_receiver_ids());
+        v.member("timestamp", x.get_timestamp());
+        v.member("type", x.get_type());
+        v.member("version", x.get_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Pose2D & x) {
+        v.member("orientation_unit", x.get_mutable_orientation_unit());
+        v.member("position_unit", x.get_mutable_position_unit());
+        v.member("reference_id", x.get_mutable_reference_id());
+        v.member("theta", x.get_mutable_theta());
+        v.member("x", x.get_mutable_x());
+        v.member("y", x.get_mutable_y());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Pose2D & x) {
+        v.member("orientation_unit", x.get_orientation_unit());
+        v.member("position_unit", x.get_position_unit());
+        v.member("reference_id", x.get_reference_id());
+        v.member("theta", x.get_theta());
+        v.member("x", x.get_x());
+        v.member("y", x.get_y());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Payload & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("pose", x.get_mutable_pose());
+        v.member("robot_id", x.get_mutable_robot_id());
+        v.member("timestamp", x.get_mutable_timestamp());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Payload & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("pose", x.get_pose());
+        v.member("robot_id", x.get_robot_id());
+        v.member("timestamp", x.get_timestamp());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, RopodRobotPose2DSchema & x) {
+        v.member("header", x.get_mutable_header());
+        v.member("payload", x.get_mutable_payload());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const RopodRobotPose2DSchema & x) {
+        v.member("header", x.get_header());
+        v.member("payload", x.get_payload());
+    }
+}
+}
+
+namespace quicktype {
+namespace task_request {
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Header & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("msg_id", x.get_mutable_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_mutable_receiver_ids());
+        v.member("timestamp", x.get_mutable_timestamp());
+        v.member("type", x.get_mutable_type());
+        v.member("version", x.get_mutable_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Header & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("msg_id", x.get_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_receiver_ids());
+        v.member("timestamp", x.get_timestamp());
+        v.member("type", x.get_type());
+        v.member("version", x.get_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Payload & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("delivery_location", x.get_mutable_delivery_location());
+        v.member("delivery_location_level", x.get_mutable_delivery_location_level());
+        v.member("earliest_start_time", x.get_mutable_earliest_start_time());
+        v.member("latest_start_time", x.get_mutable_latest_start_time());
+        v.member("load_id", x.get_mutable_load_id());
+        v.member("load_type", x.get_mutable_load_type());
+        v.member("pickup_location", x.get_mutable_pickup_location());
+        v.member("pickup_location_level", x.get_mutable_pickup_location_level());
+        v.member("priority", x.get_mutable_priority());
+        v.member("user_id", x.get_mutable_user_id());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Payload & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("delivery_location", x.get_delivery_location());
+        v.member("delivery_location_level", x.get_delivery_location_level());
+        v.member("earliest_start_time", x.get_earliest_start_time());
+        v.member("latest_start_time", x.get_latest_start_time());
+        v.member("load_id", x.get_load_id());
+        v.member("load_type", x.get_load_type());
+        v.member("pickup_location", x.get_pickup_location());
+        v.member("pickup_location_level", x.get_pickup_location_level());
+        v.member("priority", x.get_priority());
+        v.member("user_id", x.get_user_id());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, RopodTaskRequestSchema & x) {
+        v.member("header", x.get_mutable_header());
+        v.member("payload", x.get_mutable_payload());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const RopodTaskRequestSchema & x) {
+        v.member("header", x.get_header());
+        v.member("payload", x.get_payload());
+    }
+}
+}
+
+namespace quicktype {
+namespace task {
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Header & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("msg_id", x.get_mutable_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_mutable_receiver_ids());
+        v.member("timestamp", x.get_mutable_timestamp());
+        v.member("type", x.get_mutable_type());
+        v.member("version", x.get_mutable_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Header & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("msg_id", x.get_msg_id(), Header::get_msg_id_constraint());
+        v.member("receiver_ids", x.get_receiver_ids());
+        v.member("timestamp", x.get_timestamp());
+        v.member("type", x.get_type());
+        v.member("version", x.get_version());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, GeometricNode & x) {
+        v.member("floor_nr", x.get_mutable_floor_nr());
+        v.member("reference_id", x.get_mutable_reference_id());
+        v.member("unit", x.get_mutable_unit());
+        v.member("x", x.get_mutable_x());
+        v.member("y", x.get_mutable_y());
+        v.member("z", x.get_mutable_z());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const GeometricNode & x) {
+        v.member("floor_nr", x.get_floor_nr());
+        v.member("reference_id", x.get_reference_id());
+        v.member("unit", x.get_unit());
+        v.member("x", x.get_x());
+        v.member("y", x.get_y());
+        v.member("z", x.get_z());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, TopologicNode & x) {
+        v.member("debug_area_nodes", x.get_mutable_debug_area_nodes());
+        v.member("debug_waypoint", x.get_mutable_debug_waypoint());
+        v.member("id", x.get_mutable_id(), TopologicNode::get_id_constraint());
+        v.member("name", x.get_mutable_name());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const TopologicNode & x) {
+        v.member("debug_area_nodes", x.get_debug_area_nodes());
+        v.member("debug_waypoint", x.get_debug_waypoint());
+        v.member("id", x.get_id(), TopologicNode::get_id_constraint());
+        v.member("name", x.get_name());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Action & x) {
+        v.member("action_id", x.get_mutable_action_id(), Action::get_action_id_constraint());
+        v.member("action_type", x.get_mutable_action_type());
+        v.member("areas", x.get_mutable_areas());
+        v.member("estimated_duration", x.get_mutable_estimated_duration(), Action::get_estimated_duration_constraint());
+        v.member("elevator_id", x.get_mutable_elevator_id(), Action::get_elevator_id_constraint());
+        v.member("estimated_arrival_time", x.get_mutable_estimated_arrival_time());
+        v.member("level", x.get_mutable_level());
+        v.member("goal_floor", x.get_mutable_goal_floor());
+        v.member("start_floor", x.get_mutable_start_floor());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Action & x) {
+        v.member("action_id", x.get_action_id(), Action::get_action_id_constraint());
+        v.member("action_type", x.get_action_type());
+        v.member("areas", x.get_areas());
+        v.member("estimated_duration", x.get_estimated_duration(), Action::get_estimated_duration_constraint());
+        v.member("elevator_id", x.get_elevator_id(), Action::get_elevator_id_constraint());
+        v.member("estimated_arrival_time", x.get_estimated_arrival_time());
+        v.member("level", x.get_level());
+        v.member("goal_floor", x.get_goal_floor());
+        v.member("start_floor", x.get_start_floor());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, Payload & x) {
+        v.member("metamodel", x.get_mutable_metamodel());
+        v.member("actions", x.get_mutable_actions());
+        v.member("delivery_location", x.get_mutable_delivery_location());
+        v.member("earliest_finish_time", x.get_mutable_earliest_finish_time());
+        v.member("earliest_start_time", x.get_mutable_earliest_start_time());
+        v.member("finish_time", x.get_mutable_finish_time());
+        v.member("latest_finish_time", x.get_mutable_latest_finish_time());
+        v.member("latest_start_time", x.get_mutable_latest_start_time());
+        v.member("load_id", x.get_mutable_load_id());
+        v.member("load_type", x.get_mutable_load_type());
+        v.member("pickup_location", x.get_mutable_pickup_location());
+        v.member("priority", x.get_mutable_priority());
+        v.member("start_time", x.get_mutable_start_time());
+        v.member("status", x.get_mutable_status());
+        v.member("task_id", x.get_mutable_task_id(), Payload::get_task_id_constraint());
+        v.member("team_robot_ids", x.get_mutable_team_robot_ids());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const Payload & x) {
+        v.member("metamodel", x.get_metamodel());
+        v.member("actions", x.get_actions());
+        v.member("delivery_location", x.get_delivery_location());
+        v.member("earliest_finish_time", x.get_earliest_finish_time());
+        v.member("earliest_start_time", x.get_earliest_start_time());
+        v.member("finish_time", x.get_finish_time());
+        v.member("latest_finish_time", x.get_latest_finish_time());
+        v.member("latest_start_time", x.get_latest_start_time());
+        v.member("load_id", x.get_load_id());
+        v.member("load_type", x.get_load_type());
+        v.member("pickup_location", x.get_pickup_location());
+        v.member("priority", x.get_priority());
+        v.member("start_time", x.get_start_time());
+        v.member("status", x.get_status());
+        v.member("task_id", x.get_task_id(), Payload::get_task_id_constraint());
+        v.member("team_robot_ids", x.get_team_robot_ids());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, RopodTaskSchema & x) {
+        v.member("header", x.get_mutable_header());
+        v.member("payload", x.get_mutable_payload());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const RopodTaskSchema & x) {
+        v.member("header", x.get_header());
+        v.member("payload", x.get_payload());
+    }
+}
+}
+
+namespace quicktype {
+namespace units {
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, RopodUnitsSchema & x) {
+        v.member("unit", x.get_mutable_unit());
+        v.member("value", x.get_mutable_value());
+    }
+
+    template <typename Visitor>
+    inline void visit_members(Visitor & v, const RopodUnitsSchema & x) {
+        v.member("unit", x.get_unit());
+        v.member("value", x.get_value());
+    }
+}
+}
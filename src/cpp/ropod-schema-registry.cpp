@@ -0,0 +1,411 @@
+//  Decodes ropod messages of any schema into a quicktype::Message and dispatches them to
+//  handlers by header type. Include this file instead of the individual schema headers:
+//
+//     quicktype::MessageDispatcher dispatcher;
+//     dispatcher.on<quicktype::RopodRobotPose2DSchema>([](const quicktype::RopodRobotPose2DSchema & pose) { ... });
+//     dispatcher.dispatch(jsonString);
+//
+//  or, to get the message itself,
+//
+//     quicktype::Message message = quicktype::decode_message(jsonString);
+//
+//  The classes of each schema are in a namespace of their own, quicktype::task,
+//  quicktype::robot_pose_2d and so on. Root classes are also found as quicktype::RopodTaskSchema;
+//  names several schemas define, like Header and Payload, need the schema namespace.
+
+#pragma once
+
+#include "ropod-black-box-data-query-schema.cpp"
+#include "ropod-black-box-latest-data-query-schema.cpp"
+#include "ropod-black-box-logging-cmd-schema.cpp"
+#include "ropod-black-box-variable-query-schema.cpp"
+#include "ropod-cmd-schema.cpp"
+#include "ropod-component-monitor-schema.cpp"
+#include "ropod-elevator-cmd-schema.cpp"
+#include "ropod-elevator-status-schema.cpp"
+#include "ropod-experiment-cancel.cpp"
+#include "ropod-experiment-request.cpp"
+#include "ropod-experiment-sm-schema.cpp"
+#include "ropod-fms-elevator-schema.cpp"
+#include "ropod-msg-schema.cpp"
+#include "ropod-robot-pose-2d-schema.cpp"
+#include "ropod-task-request-schema.cpp"
+#include "ropod-task-schema.cpp"
+
+namespace quicktype {
+    /**
+     * The message schemas, in the order of the alternatives of Message. MSG is the generic
+     * envelope every message conforms to; it is used for header types no other schema
+     * describes.
+     */
+    enum class MessageSchema : int { BLACK_BOX_DATA_QUERY, BLACK_BOX_LATEST_DATA_QUERY, BLACK_BOX_LOGGING_CMD, BLACK_BOX_VARIABLE_QUERY, CMD, COMPONENT_MONITOR, ELEVATOR_CMD, ELEVATOR_STATUS, EXPERIMENT_CANCEL, EXPERIMENT_REQUEST, EXPERIMENT_SM, FMS_ELEVATOR, MSG, ROBOT_POSE_2D, TASK_REQUEST, TASK };
+
+    constexpr size_t message_schema_count = 16;
+
+    /**
+     * The name of the schema file, e.g. ropod-task-schema.json.
+     */
+    constexpr boost::string_view enum_name(MessageSchema x) {
+        switch (x) {
+            case MessageSchema::BLACK_BOX_DATA_QUERY: return boost::string_view("ropod-black-box-data-query-schema.json", 38);
+            case MessageSchema::BLACK_BOX_LATEST_DATA_QUERY: return boost::string_view("ropod-black-box-latest-data-query-schema.json", 45);
+            case MessageSchema::BLACK_BOX_LOGGING_CMD: return boost::string_view("ropod-black-box-logging-cmd-schema.json", 39);
+            case MessageSchema::BLACK_BOX_VARIABLE_QUERY: return boost::string_view("ropod-black-box-variable-query-schema.json", 42);
+            case MessageSchema::CMD: return boost::string_view("ropod-cmd-schema.json", 21);
+            case MessageSchema::COMPONENT_MONITOR: return boost::string_view("ropod-component-monitor-schema.json", 35);
+            case MessageSchema::ELEVATOR_CMD: return boost::string_view("ropod-elevator-cmd-schema.json", 30);
+            case MessageSchema::ELEVATOR_STATUS: return boost::string_view("ropod-elevator-status-schema.json", 33);
+            case MessageSchema::EXPERIMENT_CANCEL: return boost::string_view("ropod-experiment-cancel.json", 28);
+            case MessageSchema::EXPERIMENT_REQUEST: return boost::string_view("ropod-experiment-request.json", 29);
+            case MessageSchema::EXPERIMENT_SM: return boost::string_view("ropod-experiment-sm-schema.json", 31);
+            case MessageSchema::FMS_ELEVATOR: return boost::string_view("ropod-fms-elevator-schema.json", 30);
+            case MessageSchema::MSG: return boost::string_view("ropod-msg-schema.json", 21);
+            case MessageSchema::ROBOT_POSE_2D: return boost::string_view("ropod-robot-pose-2d-schema.json", 31);
+            case MessageSchema::TASK_REQUEST: return boost::string_view("ropod-task-request-schema.json", 30);
+            case MessageSchema::TASK: return boost::string_view("ropod-task-schema.json", 22);
+        }
+        return boost::string_view();
+    }
+
+    using Message = boost::variant<
+        black_box_data_query::RopodBlackBoxDataQuerySchema,
+        black_box_latest_data_query::RopodBlackBoxLatestDataQuerySchema,
+        black_box_logging_cmd::RopodBlackBoxLoggingCmdSchema,
+        black_box_variable_query::RopodBlackBoxVariableQuerySchema,
+        cmd::RopodCmdSchema,
+        component_monitor::RopodComponentMonitorSchema,
+        elevator_cmd::RopodElevatorCmdSchema,
+        elevator_status::RopodElevatorStatusSchema,
+        experiment_cancel::RopodExperimentCancel,
+        experiment_request::RopodExperimentRequest,
+        experiment_sm::RopodExperimentSmSchema,
+        fms_elevator::RopodFmsElevatorSchema,
+        msg::RopodMsgSchema,
+        robot_pose_2d::RopodRobotPose2DSchema,
+        task_request::RopodTaskRequestSchema,
+        task::RopodTaskSchema>;
+
+    /**
+     * The MessageSchema of a Message alternative, MessageSchemaOf<RopodTaskSchema>::value.
+     */
+    template <typename T>
+    struct MessageSchemaOf;
+
+    template <>
+    struct MessageSchemaOf<black_box_data_query::RopodBlackBoxDataQuerySchema> {
+        static constexpr MessageSchema value = MessageSchema::BLACK_BOX_DATA_QUERY;
+    };
+
+    template <>
+    struct MessageSchemaOf<black_box_latest_data_query::RopodBlackBoxLatestDataQuerySchema> {
+        static constexpr MessageSchema value = MessageSchema::BLACK_BOX_LATEST_DATA_QUERY;
+    };
+
+    template <>
+    struct MessageSchemaOf<black_box_logging_cmd::RopodBlackBoxLoggingCmdSchema> {
+        static constexpr MessageSchema value = MessageSchema::BLACK_BOX_LOGGING_CMD;
+    };
+
+    template <>
+    struct MessageSchemaOf<black_box_variable_query::RopodBlackBoxVariableQuerySchema> {
+        static constexpr MessageSchema value = MessageSchema::BLACK_BOX_VARIABLE_QUERY;
+    };
+
+    template <>
+    struct MessageSchemaOf<cmd::RopodCmdSchema> {
+        static constexpr MessageSchema value = MessageSchema::CMD;
+    };
+
+    template <>
+    struct MessageSchemaOf<component_monitor::RopodComponentMonitorSchema> {
+        static constexpr MessageSchema value = MessageSchema::COMPONENT_MONITOR;
+    };
+
+    template <>
+    struct MessageSchemaOf<elevator_cmd::RopodElevatorCmdSchema> {
+        static constexpr MessageSchema value = MessageSchema::ELEVATOR_CMD;
+    };
+
+    template <>
+    struct MessageSchemaOf<elevator_status::RopodElevatorStatusSchema> {
+        static constexpr MessageSchema value = MessageSchema::ELEVATOR_STATUS;
+    };
+
+    template <>
+    struct MessageSchemaOf<experiment_cancel::RopodExperimentCancel> {
+        static constexpr MessageSchema value = MessageSchema::EXPERIMENT_CANCEL;
+    };
+
+    template <>
+    struct MessageSchemaOf<experiment_request::RopodExperimentRequest> {
+        static constexpr MessageSchema value = MessageSchema::EXPERIMENT_REQUEST;
+    };
+
+    template <>
+    struct MessageSchemaOf<experiment_sm::RopodExperimentSmSchema> {
+        static constexpr MessageSchema value = MessageSchema::EXPERIMENT_SM;
+    };
+
+    template <>
+    struct MessageSchemaOf<fms_elevator::RopodFmsElevatorSchema> {
+        static constexpr MessageSchema value = MessageSchema::FMS_ELEVATOR;
+    };
+
+    template <>
+    struct MessageSchemaOf<msg::RopodMsgSchema> {
+        static constexpr MessageSchema value = MessageSchema::MSG;
+    };
+
+    template <>
+    struct MessageSchemaOf<robot_pose_2d::RopodRobotPose2DSchema> {
+        static constexpr MessageSchema value = MessageSchema::ROBOT_POSE_2D;
+    };
+
+    template <>
+    struct MessageSchemaOf<task_request::RopodTaskRequestSchema> {
+        static constexpr MessageSchema value = MessageSchema::TASK_REQUEST;
+    };
+
+    template <>
+    struct MessageSchemaOf<task::RopodTaskSchema> {
+        static constexpr MessageSchema value = MessageSchema::TASK;
+    };
+
+    inline MessageSchema get_schema(const Message & x) { return static_cast<MessageSchema>(x.which()); }
+
+    /**
+     * The schema of messages with the given header type, looked up in a table indexed by the
+     * top five bits of a seeded hash_key that maps each type name to its own slot (a perfect
+     * hash). Returns false for types without a specific schema.
+     */
+    inline bool message_schema_from_type(boost::string_view type, MessageSchema & x) {
+        struct Slot {
+            boost::string_view type;
+            MessageSchema schema;
+        };
+        static const Slot slots[32] = {
+            { "", MessageSchema::MSG },
+            { "ROBOT-CALL-UPDATE", MessageSchema::FMS_ELEVATOR },
+            { "BLACK-BOX-LOGGING-CMD", MessageSchema::BLACK_BOX_LOGGING_CMD },
+            { "", MessageSchema::MSG },
+            { "VARIABLE-QUERY", MessageSchema::BLACK_BOX_VARIABLE_QUERY },
+            { "ELEVATOR-CMD-REPLY", MessageSchema::ELEVATOR_CMD },
+            { "ROBOT-POSE-2D", MessageSchema::ROBOT_POSE_2D },
+            { "ELEVATOR-STATUS", MessageSchema::ELEVATOR_STATUS },
+            { "CMD", MessageSchema::CMD },
+            { "", MessageSchema::MSG },
+            { "", MessageSchema::MSG },
+            { "HEALTH-STATUS", MessageSchema::COMPONENT_MONITOR },
+            { "", MessageSchema::MSG },
+            { "DATA-QUERY", MessageSchema::BLACK_BOX_DATA_QUERY },
+            { "ELEVATOR-STATUS-QUERY", MessageSchema::ELEVATOR_STATUS },
+            { "ROBOT-ELEVATOR-CALL-REPLY", MessageSchema::FMS_ELEVATOR },
+            { "LATEST-DATA-QUERY", MessageSchema::BLACK_BOX_LATEST_DATA_QUERY },
+            { "", MessageSchema::MSG },
+            { "ROBOT-EXPERIMENT-SM", MessageSchema::EXPERIMENT_SM },
+            { "", MessageSchema::MSG },
+            { "EXPERIMENT-CANCEL", MessageSchema::EXPERIMENT_CANCEL },
+            { "", MessageSchema::MSG },
+            { "", MessageSchema::MSG },
+            { "", MessageSchema::MSG },
+            { "TASK-REQUEST", MessageSchema::TASK_REQUEST },
+            { "ROBOT-ELEVATOR-CALL-REQUEST", MessageSchema::FMS_ELEVATOR },
+            { "", MessageSchema::MSG },
+            { "EXPERIMENT-REQUEST", MessageSchema::EXPERIMENT_REQUEST },
+            { "ELEVATOR-CMD", MessageSchema::ELEVATOR_CMD },
+            { "", MessageSchema::MSG },
+            { "TASK", MessageSchema::TASK },
+            { "", MessageSchema::MSG },
+        };
+        const Slot & slot = slots[hash_key(type.data(), type.size(), 0x905d1d20u) >> 27];
+        if (slot.type.empty() || slot.type != type) return false;
+        x = slot.schema;
+        return true;
+    }
+
+    /**
+     * Reads header.type of a message of any schema. Members in front of the header and in
+     * front of the type are skipped, and reading stops right after the type. Returns false and
+     * leaves the error in r if the message has no header type.
+     */
+    inline bool peek_message_type(JsonReader & r, boost::string_view & type) {
+        if (!r.begin_object()) return false;
+        boost::string_view key;
+        while (r.next_member(key)) {
+            if (key != "header") {
+                r.skip_value();
+                continue;
+            }
+            if (r.begin_object()) {
+                while (r.next_member(key)) {
+                    if (key == "type") {
+                        r.read(type);
+                        if (r.ok()) return true;
+                        r.add_error_key("type");
+                        break;
+                    }
+                    r.skip_value();
+                }
+                r.fail_missing_key("type");
+            }
+            r.add_error_key("header");
+            return false;
+        }
+        r.fail_missing_key("header");
+        return false;
+    }
+
+    template <typename T>
+    inline void read_message_as(JsonReader & r, Message & x) {
+        x = T();
+        read_json(r, boost::get<T>(x));
+    }
+
+    /**
+     * Reads a message known to be of the given schema.
+     */
+    inline void read_message(JsonReader & r, MessageSchema schema, Message & x) {
+        using Reader = void (*)(JsonReader &, Message &);
+        static const Reader readers[message_schema_count] = {
+            &read_message_as<black_box_data_query::RopodBlackBoxDataQuerySchema>,
+            &read_message_as<black_box_latest_data_query::RopodBlackBoxLatestDataQuerySchema>,
+            &read_message_as<black_box_logging_cmd::RopodBlackBoxLoggingCmdSchema>,
+            &read_message_as<black_box_variable_query::RopodBlackBoxVariableQuerySchema>,
+            &read_message_as<cmd::RopodCmdSchema>,
+            &read_message_as<component_monitor::RopodComponentMonitorSchema>,
+            &read_message_as<elevator_cmd::RopodElevatorCmdSchema>,
+            &read_message_as<elevator_status::RopodElevatorStatusSchema>,
+            &read_message_as<experiment_cancel::RopodExperimentCancel>,
+            &read_message_as<experiment_request::RopodExperimentRequest>,
+            &read_message_as<experiment_sm::RopodExperimentSmSchema>,
+            &read_message_as<fms_elevator::RopodFmsElevatorSchema>,
+            &read_message_as<msg::RopodMsgSchema>,
+            &read_message_as<robot_pose_2d::RopodRobotPose2DSchema>,
+            &read_message_as<task_request::RopodTaskRequestSchema>,
+            &read_message_as<task::RopodTaskSchema>
+        };
+        readers[static_cast<int>(schema)](r, x);
+    }
+
+    /**
+     * Reads a message of any schema, chosen by its header type, so that decode<Message>,
+     * decode_batch and Lazy<Message> work as for a single schema.
+     */
+    inline void read_json(JsonReader & r, Message & x) {
+        JsonReader peek = r;
+        boost::string_view type;
+        if (!peek_message_type(peek, type)) {
+            r = peek;
+            return;
+        }
+        MessageSchema schema = MessageSchema::MSG;
+        message_schema_from_type(type, schema);
+        read_message(r, schema, x);
+    }
+
+    /**
+     * Decodes a message known to be of the given schema.
+     */
+    inline Expected<Message> try_decode_message(MessageSchema schema, const char * data, size_t size) {
+        JsonReader r(data, size);
+        Expected<Message> message = Message();
+        read_message(r, schema, *message);
+        r.finish();
+        if (!r.ok()) return r.get_error();
+        return message;
+    }
+
+    /**
+     * Decodes a message of any schema, chosen by its header type. Like try_decode, failures
+     * are reported as a DecodeError.
+     */
+    inline Expected<Message> try_decode_message(const char * data, size_t size) {
+        JsonReader r(data, size);
+        boost::string_view type;
+        if (!peek_message_type(r, type)) return r.get_error();
+        MessageSchema schema = MessageSchema::MSG;
+        message_schema_from_type(type, schema);
+        return try_decode_message(schema, data, size);
+    }
+
+    inline Expected<Message> try_decode_message(const std::string & text) {
+        return try_decode_message(text.data(), text.size());
+    }
+
+    /**
+     * Decodes a message of any schema, chosen by its header type. Throws JsonDecodeException
+     * if the message does not decode.
+     */
+    inline Message decode_message(const char * data, size_t size) {
+        Expected<Message> message = try_decode_message(data, size);
+        if (!message) throw JsonDecodeException(message.error().to_string());
+        return std::move(*message);
+    }
+
+    inline Message decode_message(const std::string & text) {
+        return decode_message(text.data(), text.size());
+    }
+
+    /**
+     * Calls the handler registered for the schema of each message it is given. The schema is
+     * found from the header type, which is read without decoding the rest of the message, by
+     * a table lookup; only messages with a handler are decoded. Decode failures are passed to
+     * the error handler. Handlers are not synchronized: register them before dispatching from
+     * several threads.
+     */
+    class MessageDispatcher {
+        private:
+        std::function<void(const Message &)> handlers[message_schema_count];
+        std::function<void(const DecodeError &)> error_handler;
+
+        public:
+        /**
+         * Registers handler, called with a const T &, for messages of schema T, replacing the
+         * handler registered before.
+         */
+        template <typename T, typename Handler>
+        void on(Handler handler) {
+            handlers[static_cast<int>(MessageSchemaOf<T>::value)] = [handler](const Message & message) { handler(boost::get<T>(message)); };
+        }
+
+        void on_error(std::function<void(const DecodeError &)> handler) { this->error_handler = std::move(handler); }
+
+        bool handles(MessageSchema schema) const { return static_cast<bool>(handlers[static_cast<int>(schema)]); }
+
+        /**
+         * Decodes the message and calls its handler. Returns false if no handler was called,
+         * because there is none for the schema or the message did not decode.
+         */
+        bool dispatch(const char * data, size_t size) const {
+            JsonReader r(data, size);
+            boost::string_view type;
+            if (!peek_message_type(r, type)) {
+                if (error_handler) error_handler(r.get_error());
+                return false;
+            }
+            MessageSchema schema = MessageSchema::MSG;
+            message_schema_from_type(type, schema);
+            const std::function<void(const Message &)> & handler = handlers[static_cast<int>(schema)];
+            if (!handler) return false;
+            Expected<Message> message = try_decode_message(schema, data, size);
+            if (!message) {
+                if (error_handler) error_handler(message.error());
+                return false;
+            }
+            handler(*message);
+            return true;
+        }
+
+        bool dispatch(const std::string & text) const { return dispatch(text.data(), text.size()); }
+
+        /**
+         * Calls the handler for a message already decoded. Returns false if there is none.
+         */
+        bool handle(const Message & message) const {
+            const std::function<void(const Message &)> & handler = handlers[message.which()];
+            if (!handler) return false;
+            handler(message);
+            return true;
+        }
+    };
+}
@@ -0,0 +1,1133 @@
+//  Behaviour tests of the generated models and the helpers in src/cpp. Build and run it with
+//  the include paths of nlohmann/json and Boost added:
+//
+//     g++ -std=c++14 -O1 -Isrc/cpp -pthread test/ropod-models-test.cpp -o ropod-models-test
+//     ./ropod-models-test [TEXT]
+//
+//  Every test prints one line; the program exits non-zero if a check failed. TEXT runs only
+//  the tests whose name contains it. Add -DQUICKTYPE_INLINE_OPTIONALS to test inline
+//  optionals.
+
+#include "ropod-ingest-pipeline.cpp"
+#include "ropod-message-generator.cpp"
+
+#include <cctype>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
+
+namespace {
+    using namespace quicktype;
+
+    size_t failed_checks = 0;
+
+    void report(bool passed, const char * expression, const char * file, int line) {
+        if (passed) return;
+        std::cerr << file << ":" << line << ": check failed: " << expression << std::endl;
+        failed_checks++;
+    }
+
+#define CHECK(expression) report(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
+#define CHECK_THROWS(Exception, expression) \
+    do { \
+        bool thrown = false; \
+        try { expression; } catch (const Exception &) { thrown = true; } \
+        report(thrown, #expression " throws " #Exception, __FILE__, __LINE__); \
+    } while (false)
+
+    const char * const pose_text =
+        R"({"header":{"metamodel":"ropod-msg-schema.json","msgId":"5b6c8f0e-9b1d-4c4e-8d4a-2f0b1c3d4e01",)"
+        R"("receiverIds":["receiverIds_2"],"timestamp":1521626403.125,"type":"ROBOT-POSE-2D","version":"version_5"},)"
+        R"("payload":{"metamodel":"ropod-robot-pose-2d-schema.json","pose":{"orientationUnit":"rad","positionUnit":"m",)"
+        R"("referenceId":"referenceId_4","theta":7.501,"x":8.751,"y":10.001},"robotId":"robotId_3","timestamp":1521626404.125}})";
+
+    void test_pattern() {
+        std::mt19937_64 random(1);
+        const auto mutated = [&](std::string text) {
+            const size_t at = text.empty() ? 0 : random() % text.size();
+            switch (random() % 6) {
+                case 0: if (!text.empty()) text.erase(at, 1); break;
+                case 1: text.insert(at, 1, static_cast<char>(random() % 256)); break;
+                case 2: if (!text.empty()) text[at] = static_cast<char>(random() % 256); break;
+                case 3: if (!text.empty()) text[at] = static_cast<char>(std::isupper(static_cast<unsigned char>(text[at])) ? std::tolower(static_cast<unsigned char>(text[at])) : std::toupper(static_cast<unsigned char>(text[at]))); break;
+                case 4: text += text.empty() ? 'x' : text.back(); break;
+                default: if (!text.empty()) text[at] = "09afgAFG:-x"[random() % 11]; break;
+            }
+            return text;
+        };
+
+        // compiled into per-position tables, which must agree with std::regex_search
+        for (const char * pattern : {
+            "^[a-fA-F0-9]{8}-[a-fA-F0-9]{4}-[a-fA-F0-9]{4}-[a-fA-F0-9]{4}-[a-fA-F0-9]{12}$",
+            "^[0-9]{2}:[0-9]{2}:[0-9]{2}$", "^[a-f0-9]{4}$", "^[A-Z][a-z]{3}-x$", "^abc$", "^$"
+        }) {
+            const ClassMemberPattern & matcher = ClassMemberPattern::get(pattern);
+            const std::regex regex(pattern);
+            CHECK(matcher.is_fixed_width());
+            for (int i = 0; i < 2000; i++) {
+                std::string text;
+                CHECK(matcher.sample(random, text) && matcher.matches(text) && std::regex_search(text, regex));
+                for (int j = 0; j < 1 + i % 3; j++) text = mutated(text);
+                CHECK(matcher.matches(text) == std::regex_search(text, regex));
+            }
+        }
+        CHECK(!ClassMemberPattern::get("^[0-9]{2}:[0-9]{2}:[0-9]{2}$").matches("12:34:5"));
+        CHECK(!ClassMemberPattern::get("^[0-9]{2}:[0-9]{2}:[0-9]{2}$").matches("12:34:567"));
+        CHECK(!ClassMemberPattern::get("^[a-f0-9]{4}$").matches("AB12"));
+        CHECK(!ClassMemberPattern::get("^[a-f0-9]{4}$").matches(std::string("ab\0" "1", 4)));
+
+        // everything else falls back to std::regex
+        for (const char * pattern : { "^[0-9]{2,3}$", "^\\d{2}$", "^[^a]$", "abc", "^a*$", "^(ab)$", "^a|b$", "^a.c$" }) {
+            const ClassMemberPattern & matcher = ClassMemberPattern::get(pattern);
+            const std::regex regex(pattern);
+            CHECK(!matcher.is_fixed_width());
+            std::string text;
+            CHECK(!matcher.sample(random, text));
+            for (const char * value : { "", "a", "b", "ab", "abc", "xabcx", "12", "123", "1234", "a1c" }) {
+                CHECK(matcher.matches(value) == std::regex_search(std::string(value), regex));
+            }
+        }
+    }
+
+    /**
+     * Checks enum_name and enum_from_name of E over all of its values and returns their count:
+     * every name maps back to its value, and a string that is not one of the names, however
+     * close or whatever slot of the table it hashes to, is rejected.
+     */
+    template <typename E>
+    size_t check_enum_table() {
+        std::set<std::string> names;
+        int count = 0;
+        for (; !enum_name(static_cast<E>(count)).empty(); count++) {
+            const E x = static_cast<E>(count);
+            const std::string name = enum_name(x).to_string();
+            E read = static_cast<E>(-1);
+            CHECK(enum_from_name(name, read) && read == x);
+            CHECK(json(x) == name && json(name).get<E>() == x);
+            names.insert(name);
+        }
+        CHECK(names.size() == static_cast<size_t>(count));
+
+        const auto check_rejected = [&](const std::string & text) {
+            E read = static_cast<E>(-1);
+            const bool found = enum_from_name(text, read);
+            CHECK(found == (names.count(text) == 1));
+            if (found) CHECK(enum_name(read) == text);
+            else CHECK(read == static_cast<E>(-1));
+        };
+        for (const std::string & name : names) {
+            check_rejected(name.substr(0, name.size() - 1));
+            check_rejected(name.substr(1));
+            check_rejected(name + " ");
+            check_rejected(" " + name);
+            check_rejected(name + std::string(1, '\0'));
+            for (size_t i = 0; i < name.size(); i++) {
+                std::string near = name;
+                near[i] = static_cast<char>(near[i] + 1);
+                check_rejected(near);
+                near[i] = static_cast<char>(std::isupper(static_cast<unsigned char>(name[i])) ? std::tolower(static_cast<unsigned char>(name[i])) : std::toupper(static_cast<unsigned char>(name[i])));
+                check_rejected(near);
+            }
+        }
+        // the tables have 256 slots, so on average one in 256 of these strings hashes to the
+        // slot of each name without being it
+        std::mt19937_64 random(6);
+        for (int i = 0; i < 50000; i++) {
+            std::string text(1 + random() % 6, ' ');
+            for (char & c : text) c = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_-./\xc2\xb0"[random() % 68];
+            check_rejected(text);
+        }
+        check_rejected("");
+        return static_cast<size_t>(count);
+    }
+
+    void test_enum_tables() {
+        CHECK(check_enum_table<units::Unit>() == 37);
+        CHECK(check_enum_table<black_box_data_query::MsgMetamodel>() > 0);
+        CHECK(check_enum_table<black_box_data_query::GenericType>() > 0);
+        CHECK(check_enum_table<black_box_latest_data_query::MsgMetamodel>() > 0);
+        CHECK(check_enum_table<black_box_latest_data_query::GenericType>() > 0);
+        CHECK(check_enum_table<black_box_logging_cmd::MsgMetamodel>() > 0);
+        CHECK(check_enum_table<black_box_logging_cmd::GenericType>() > 0);
+        CHECK(check_enum_table<black_box_logging_cmd::Cmd>() > 0);
+        CHECK(check_enum_table<black_box_variable_query::MsgMetamodel>() > 0);
+        CHECK(check_enum_table<black_box_variable_query::GenericType>() > 0);
+        CHECK(check_enum_table<cmd::MsgMetamodel>() > 0);
+        CHECK(check_enum_table<cmd::TypeEnum>() > 0);
+        CHECK(check_enum_table<cmd::Command>() > 0);
+        CHECK(check_enum_table<cmd::MetamodelEnum>() > 0);
+        CHECK(check_enum_table<component_monitor::MsgMetamodel>() > 0);
+        CHECK(check_enum_table<component_monitor::GenericType>() > 0);
+        CHECK(check_enum_table<elevator_cmd::MsgMetamodel>() > 0);
+        CHECK(check_enum_table<elevator_cmd::TypeEnum>() > 0);
+        CHECK(check_enum_table<elevator_cmd::Command>() > 0);
+        CHECK(check_enum_table<elevator_cmd::MetamodelEnum>() > 0);
+        CHECK(check_enum_table<elevator_cmd::OperationalMode>() > 0);
+        CHECK(check_enum_table<elevator_status::MsgMetamodel>() > 0);
+        CHECK(check_enum_table<elevator_status::TypeEnum>() > 0);
+        CHECK(check_enum_table<elevator_status::MetamodelEnum>() > 0);
+        CHECK(check_enum_table<elevator_status::Query>() > 0);
+        CHECK(check_enum_table<experiment_cancel::MsgMetamodel>() > 0);
+        CHECK(check_enum_table<experiment_cancel::GenericType>() > 0);
+        CHECK(check_enum_table<experiment_request::MsgMetamodel>() > 0);
+        CHECK(check_enum_table<experiment_request::GenericType>() > 0);
+        CHECK(check_enum_table<experiment_sm::MsgMetamodel>() > 0);
+        CHECK(check_enum_table<experiment_sm::TypeEnum>() > 0);
+        CHECK(check_enum_table<experiment_sm::MetamodelEnum>() > 0);
+        CHECK(check_enum_table<fms_elevator::MsgMetamodel>() > 0);
+        CHECK(check_enum_table<fms_elevator::TypeEnum>() > 0);
+        CHECK(check_enum_table<fms_elevator::Command>() > 0);
+        CHECK(check_enum_table<fms_elevator::Load>() > 0);
+        CHECK(check_enum_table<fms_elevator::MetamodelEnum>() > 0);
+        CHECK(check_enum_table<msg::MsgMetamodel>() > 0);
+        CHECK(check_enum_table<robot_pose_2d::MsgMetamodel>() > 0);
+        CHECK(check_enum_table<robot_pose_2d::TypeEnum>() > 0);
+        CHECK(check_enum_table<robot_pose_2d::MetamodelEnum>() > 0);
+        CHECK(check_enum_table<robot_pose_2d::PlaneAngleUnit>() > 0);
+        CHECK(check_enum_table<robot_pose_2d::LengthUnit>() > 0);
+        CHECK(check_enum_table<task_request::MsgMetamodel>() > 0);
+        CHECK(check_enum_table<task_request::TypeEnum>() > 0);
+        CHECK(check_enum_table<task_request::LoadType>() > 0);
+        CHECK(check_enum_table<task_request::MetamodelEnum>() > 0);
+        CHECK(check_enum_table<task::MsgMetamodel>() > 0);
+        CHECK(check_enum_table<task::TypeEnum>() > 0);
+        CHECK(check_enum_table<task::ActionType>() > 0);
+        CHECK(check_enum_table<task::LengthUnit>() > 0);
+        CHECK(check_enum_table<task::LoadType>() > 0);
+        CHECK(check_enum_table<task::MetamodelEnum>() > 0);
+    }
+
+    std::string replaced(std::string text, const std::string & from, const std::string & to) {
+        text.replace(text.find(from), from.size(), to);
+        return text;
+    }
+
+    /**
+     * peek_header over a JsonReader, the error left in the reader if there is no valid header.
+     */
+    Expected<msg::Header> peeked(const std::string & text) {
+        JsonReader r(text.data(), text.size());
+        msg::Header header;
+        if (!msg::peek_header(r, header)) return Expected<msg::Header>(r.get_error());
+        return Expected<msg::Header>(std::move(header));
+    }
+
+    void test_peek_header() {
+        const std::string text = pose_text;
+        const size_t payload = text.find(",\"payload\":");
+        const std::string header_member = text.substr(1, payload - 1);
+        const std::string payload_member = text.substr(payload + 1, text.size() - payload - 2);
+        const std::string payload_first = "{" + payload_member + "," + header_member + "}";
+        for (const std::string & message : { text, payload_first, "{\"a\":[1,{\"header\":2}]," + header_member + "}" }) {
+            const Expected<msg::Header> header = peeked(message);
+            CHECK(header);
+            if (!header) continue;
+            CHECK(header->get_type() == "ROBOT-POSE-2D");
+            CHECK(header->get_msg_id_string() == "5b6c8f0e-9b1d-4c4e-8d4a-2f0b1c3d4e01");
+            CHECK(msg::peek_header(message).get_msg_id_string() == header->get_msg_id_string());
+        }
+
+        // reading stops after a leading header, so a broken payload is not seen
+        for (const std::string & message : {
+            replaced(text, "\"x\":8.751", "\"x\" 8.751"), replaced(text, "\"x\":8.751", "\"x\":\"8.7\""), text.substr(0, payload + 12)
+        }) {
+            CHECK(peeked(message));
+        }
+        CHECK(!peeked(replaced(payload_first, "\"x\":8.751", "\"x\" 8.751")));
+        CHECK(peeked(replaced(payload_first, "\"x\":8.751", "\"x\" 8.751")).error().get_kind() == DecodeErrorKind::SYNTAX_ERROR);
+
+        for (const std::string & message : { std::string("{}"), "{" + payload_member + "}" }) {
+            const Expected<msg::Header> header = peeked(message);
+            CHECK(!header);
+            if (header) continue;
+            CHECK(header.error().get_kind() == DecodeErrorKind::MISSING_KEY);
+            CHECK(header.error().get_path() == "/header");
+            CHECK_THROWS(JsonDecodeException, msg::peek_header(message));
+        }
+        CHECK(peeked("[]").error().get_kind() == DecodeErrorKind::TYPE_MISMATCH);
+        CHECK(peeked(replaced(text, "\"msgId\":\"5b", "\"msgId\":\"xb")).error().get_kind() == DecodeErrorKind::CONSTRAINT_VIOLATION);
+    }
+
+    void test_lazy_decode() {
+        const LazyRopodRobotPose2DSchema lazy = decode<LazyRopodRobotPose2DSchema>(pose_text);
+        CHECK(lazy.get_header().get_type() == robot_pose_2d::TypeEnum::ROBOT_POSE_2_D);
+        CHECK(lazy.get_payload().get_pose().get_x() == 8.751);
+        CHECK(lazy.get_payload().get_robot_id() == "robotId_3");
+
+        std::string broken = pose_text;
+        broken.replace(broken.find("\"x\":8.751"), 9, "\"x\":\"8.7\"");
+        const LazyRopodRobotPose2DSchema invalid = decode<LazyRopodRobotPose2DSchema>(broken);
+        CHECK_THROWS(JsonDecodeException, invalid.get_payload());
+        CHECK_THROWS(JsonDecodeException, invalid.get_payload());
+    }
+
+    /**
+     * Checks that text fails to decode as a pose with the given kind, path and offset.
+     */
+    void check_decode_error(const std::string & text, DecodeErrorKind kind, const std::string & path, size_t offset) {
+        const Expected<RopodRobotPose2DSchema> pose = try_decode<RopodRobotPose2DSchema>(text);
+        CHECK(!pose);
+        if (pose) return;
+        CHECK(pose.error().get_kind() == kind);
+        CHECK(pose.error().get_path() == path);
+        CHECK(pose.error().get_offset() == offset);
+        CHECK_THROWS(JsonDecodeException, decode<RopodRobotPose2DSchema>(text));
+    }
+
+    void test_decode_errors() {
+        const std::string text = pose_text;
+        CHECK(try_decode<RopodRobotPose2DSchema>(text));
+        check_decode_error("", DecodeErrorKind::SYNTAX_ERROR, "", 0);
+        check_decode_error("[]", DecodeErrorKind::TYPE_MISMATCH, "", 0);
+        check_decode_error(text.substr(0, 50), DecodeErrorKind::SYNTAX_ERROR, "/header", 50);
+        check_decode_error(text + "x", DecodeErrorKind::SYNTAX_ERROR, "", text.size());
+        check_decode_error(replaced(text, "\"x\":8.751", "\"x\" 8.751"), DecodeErrorKind::SYNTAX_ERROR, "/payload/pose", text.find("8.751"));
+
+        const std::string missing = replaced(text, "\"robotId\":\"robotId_3\",", "");
+        check_decode_error(missing, DecodeErrorKind::MISSING_KEY, "/payload/robotId", missing.size() - 1);
+        const std::string mistyped = replaced(text, "\"x\":8.751", "\"x\":\"8.7\"");
+        check_decode_error(mistyped, DecodeErrorKind::TYPE_MISMATCH, "/payload/pose/x", mistyped.find("\"8.7\""));
+        const std::string listed = replaced(text, "[\"receiverIds_2\"]", "[\"a\",1]");
+        check_decode_error(listed, DecodeErrorKind::TYPE_MISMATCH, "/header/receiverIds/1", listed.find(",1]") + 1);
+        const std::string unknown_unit = replaced(text, "\"positionUnit\":\"m\"", "\"positionUnit\":\"parsec\"");
+        check_decode_error(unknown_unit, DecodeErrorKind::INVALID_ENUM_VALUE, "/payload/pose/positionUnit", unknown_unit.find("\"parsec\"") + 8);
+        const std::string bad_id = replaced(text, "5b6c8f0e-9b1d-4c4e-8d4a-2f0b1c3d4e01", "not-a-uuid");
+        check_decode_error(bad_id, DecodeErrorKind::CONSTRAINT_VIOLATION, "/header/msgId", bad_id.find("not-a-uuid") + 11);
+        const std::string bad_utf8 = replaced(text, "robotId_3", "robot\xff");
+        check_decode_error(bad_utf8, DecodeErrorKind::SYNTAX_ERROR, "/payload/robotId", bad_utf8.find("\xff"));
+
+        // unknown members are skipped
+        CHECK(try_decode<RopodRobotPose2DSchema>(replaced(text, "\"x\":8.751", "\"x\":8.751,\"z\":[{\"a\":null}]")));
+    }
+
+    void test_int64_range() {
+        // kind of the error reading text as an int64_t, or SYNTAX_ERROR if it was read
+        int64_t value = 0;
+        const auto read = [&value](const std::string & text) {
+            JsonReader r(text);
+            r.read(value);
+            return r.ok() ? DecodeErrorKind::SYNTAX_ERROR : r.get_error().get_kind();
+        };
+        CHECK(read("-9223372036854775808") == DecodeErrorKind::SYNTAX_ERROR && value == INT64_MIN);
+        CHECK(read("9223372036854775807") == DecodeErrorKind::SYNTAX_ERROR && value == INT64_MAX);
+        CHECK(read("1e3") == DecodeErrorKind::SYNTAX_ERROR && value == 1000);
+        CHECK(read("-2.5") == DecodeErrorKind::SYNTAX_ERROR && value == -2);
+        CHECK(read("9223372036854775808") == DecodeErrorKind::OUT_OF_RANGE);
+        CHECK(read("1e300") == DecodeErrorKind::OUT_OF_RANGE);
+        CHECK(read("-1e19") == DecodeErrorKind::OUT_OF_RANGE);
+        CHECK(read("9.3e18") == DecodeErrorKind::OUT_OF_RANGE);
+        CHECK(read("\"1\"") == DecodeErrorKind::TYPE_MISMATCH);
+    }
+
+    void test_uuid_case() {
+        for (const char * text : {
+            "5b6c8f0e-9b1d-4c4e-8d4a-2f0b1c3d4e01",
+            "5B6C8F0E-9B1D-4C4E-8D4A-2F0B1C3D4E01",
+            "5b6C8f0E-9b1d-4C4e-8D4a-2f0B1c3D4e01",
+            "12345678-1234-4123-8123-123456789012"
+        }) {
+            Uuid id;
+            CHECK(Uuid::parse(text, id) && id.to_string() == text);
+            CHECK(id == id.to_lower_case() && id.hash() == id.to_upper_case().hash());
+
+            std::string message = pose_text;
+            message.replace(message.find("5b6c8f0e"), 36, text);
+            const RopodRobotPose2DSchema pose = decode<RopodRobotPose2DSchema>(message);
+            CHECK(pose.get_header().get_msg_id_string() == text);
+            CHECK(encode(pose) == message);
+            CHECK(decode_packed<RopodRobotPose2DSchema>(encode_packed(pose)).get_header().get_msg_id_string() == text);
+        }
+
+        Uuid id;
+        CHECK(Uuid::parse("5B6C8F0E-9B1D-4C4E-8D4A-2F0B1C3D4E01", id) && id.is_upper_case() && !id.is_lower_case());
+        CHECK(id.to_lower_case().to_string() == "5b6c8f0e-9b1d-4c4e-8d4a-2f0b1c3d4e01");
+        CHECK(Uuid(1, 2).is_lower_case() && Uuid(1, 2).is_upper_case());
+        CHECK(!Uuid::parse("5b6c8f0e-9b1d-4c4e-8d4a-2f0b1c3d4e0g", id));
+        CHECK(!Uuid::parse("5b6c8f0e9b1d-4c4e-8d4a-2f0b1c3d4e01", id));
+    }
+
+    void test_instant_text() {
+        const auto round_trip = [](const char * text) {
+            Instant x;
+            return Instant::parse(text, x) ? x.to_string() : std::string("invalid");
+        };
+        // kept as received
+        for (const char * text : {
+            "2019-01-01T10:00:00.000+02:00",
+            "2019-01-01T08:00:00Z",
+            "2019-01-01T08:00:00.5Z",
+            "2019-01-01T08:00:00.123456789-09:30",
+            "1969-12-31T23:59:59.999999+00:00",
+            "2262-04-11T23:47:15.999999999Z"
+        }) {
+            CHECK(round_trip(text) == text);
+        }
+        // canonicalised
+        CHECK(round_trip("2019-01-01t08:00:00z") == "2019-01-01T08:00:00Z");
+        CHECK(round_trip("2019-01-01 08:00:00-00:00") == "2019-01-01T08:00:00-00:00");
+        CHECK(round_trip("2019-01-01T08:00:00.1234567891234Z") == "2019-01-01T08:00:00.123456789Z");
+        CHECK(round_trip("2016-12-31T23:59:60Z") == "2017-01-01T00:00:00Z");
+        // not parsed, but kept verbatim by from_string
+        for (const char * text : {
+            "yesterday", "", "2019-01-01T08:00:00", "2019-01-01T08:00:00.Z", "2019-02-29T00:00:00Z",
+            "2019-01-01T24:00:00Z", "2019-01-01T08:00:00+24:00", "2019-01-01T08:00:00+0200", "2262-04-11T23:47:16Z",
+            "9999-12-31T23:59:59Z", "0001-01-01T00:00:00Z"
+        }) {
+            CHECK(round_trip(text) == "invalid");
+            const Instant x = Instant::from_string(text);
+            CHECK(x.is_text() && x.get_verbatim() != nullptr && *x.get_verbatim() == text && x.to_string() == text);
+        }
+        CHECK(Instant::from_string("2019-01-01T08:00:00Z").get_verbatim() == nullptr);
+
+        // verbatim date-times stand for the time they name, as near as the range allows
+        const Instant deadline = Instant::from_string("9999-12-31T23:59:59Z");
+        CHECK(deadline > Instant::now() && deadline.get_nanoseconds() == INT64_C(9223372035000000000));
+        CHECK(Instant::from_string("0001-01-01T00:00:00Z").get_nanoseconds() == INT64_C(-9223372035000000000));
+        CHECK(Instant::from_string("2018-03-21T10:00:00.5").get_nanoseconds() == INT64_C(1521626400500000000));
+        CHECK(Instant::from_string("yesterday").get_nanoseconds() == 0);
+        CHECK(Instant::from_string("yesterday") != Instant(0, true) && Instant(0, true) < Instant::from_string("yesterday"));
+        CHECK(Instant::from_string("yesterday") == Instant::from_string("yesterday"));
+
+        // -00:00 is UTC with the local offset unknown, not +00:00
+        Instant unknown, zero;
+        CHECK(Instant::parse("2019-01-01T08:00:00-00:00", unknown) && Instant::parse("2019-01-01T08:00:00+00:00", zero));
+        CHECK(unknown.get_offset() == Instant::unknown_offset && zero.get_offset() == 0 && unknown == zero);
+        CHECK(InstantFormatter().to_string(unknown) == "2019-01-01T08:00:00-00:00");
+
+        // members keep them through JSON, the nlohmann path and the packed format
+        for (const char * timestamp : { "9999-12-31T23:59:59Z", "2018-03-21T10:00:00", "2019-01-01T08:00:00-00:00", "yesterday" }) {
+            const std::string text = replaced(pose_text, "1521626404.125", std::string("\"") + timestamp + "\"");
+            const Expected<robot_pose_2d::PayloadTimeStamp> read = try_decode<robot_pose_2d::PayloadTimeStamp>(std::string("\"") + timestamp + "\"");
+            CHECK(read && read->to_string() == timestamp);
+            const Expected<RopodRobotPose2DSchema> pose = try_decode<RopodRobotPose2DSchema>(text);
+            CHECK(pose && encode(*pose) == text);
+            CHECK(encode(json::parse(text).get<RopodRobotPose2DSchema>()) == text);
+            CHECK(packed_to_json<RopodRobotPose2DSchema>(json_to_packed<RopodRobotPose2DSchema>(text)) == text);
+        }
+
+        Instant a, b;
+        CHECK(Instant::parse("2019-01-01T10:00:00.000+02:00", a) && Instant::parse("2019-01-01T08:00:00Z", b) && a == b);
+        CHECK(a.get_offset() == 120 && a.get_fraction_digits() == 3 && b.get_offset() == Instant::utc);
+        CHECK(Instant(0, true).to_string() == "1970-01-01T00:00:00Z");
+        CHECK(Instant(1500000, true).to_string() == "1970-01-01T00:00:00.001500Z");
+        a.set_fraction_digits(-1);
+        a.set_offset(Instant::utc);
+        CHECK(a.to_string() == "2019-01-01T08:00:00Z");
+    }
+
+    void test_instant_members() {
+        for (const char * timestamp : { "2019-01-01T10:00:00.000+02:00", "2019-01-01T08:00:00Z", "2019-01-01T08:00:00.25-05:00" }) {
+            std::string text = pose_text;
+            text.replace(text.find("1521626403.125"), 14, std::string("\"") + timestamp + "\"");
+            const RopodRobotPose2DSchema pose = decode<RopodRobotPose2DSchema>(text);
+            CHECK(encode(pose) == text);
+            CHECK(encode(decode_packed<RopodRobotPose2DSchema>(encode_packed(pose))) == text);
+            CHECK(packed_to_json<RopodRobotPose2DSchema>(json_to_packed<RopodRobotPose2DSchema>(text)) == text);
+        }
+
+        // numeric seconds come back as the millisecond or microsecond they were written from
+        Instant read;
+        for (const int64_t nanoseconds : { INT64_C(1521691278596000000), INT64_C(1521691278596123000), INT64_C(-1000), INT64_C(253402300799999000) }) {
+            CHECK(Instant::from_seconds(Instant(nanoseconds, false).get_seconds(), read) && read.get_nanoseconds() == nanoseconds);
+        }
+        CHECK(Instant::from_seconds(0.5e-9, read) && read.get_nanoseconds() == 1);
+        const RopodRobotPose2DSchema numeric = decode<RopodRobotPose2DSchema>(pose_text);
+        CHECK(numeric.get_payload().get_timestamp().get_nanoseconds() == INT64_C(1521626404125000000));
+        CHECK(json_to_packed<RopodRobotPose2DSchema>(pose_text) == encode_packed(numeric));
+
+        const Expected<RopodRobotPose2DSchema> pose = try_decode<RopodRobotPose2DSchema>(replaced(pose_text, "1521626403.125", "[]"));
+        CHECK(!pose && pose.error().get_kind() == DecodeErrorKind::TYPE_MISMATCH && pose.error().get_path() == "/header/timestamp");
+    }
+
+    /**
+     * Checks that id is a random (version 4, RFC 4122 variant) UUID that the msgId pattern accepts.
+     */
+    void check_generated_msg_id(const Uuid & id) {
+        CHECK((id.get_high() >> 12 & 0xf) == 4);
+        CHECK((id.get_low() >> 62) == 2);
+        const std::string text = id.to_string();
+        CHECK(text.size() == 36 && text[14] == '4' && std::strchr("89ab", text[19]) != nullptr);
+        bool accepted = true;
+        try {
+            CheckConstraint("msgId", msg::Header::get_msg_id_constraint(), text);
+        } catch (const std::exception &) {
+            accepted = false;
+        }
+        CHECK(accepted);
+    }
+
+    void test_make_header() {
+        const Instant before = Instant::now();
+        const msg::Header header = msg::make_header("ROBOT-POSE-2D");
+        const Instant after = Instant::now();
+        CHECK(header.get_metamodel() == msg::MsgMetamodel::ROPOD_MSG_SCHEMA_JSON);
+        CHECK(header.get_type() == "ROBOT-POSE-2D");
+        check_generated_msg_id(header.get_msg_id());
+        CHECK(header.get_timestamp() && before <= *header.get_timestamp() && *header.get_timestamp() <= after);
+        CHECK(try_decode<msg::Header>(encode(header)));
+
+        const Instant stamp(INT64_C(1521626403125000000), true);
+        const robot_pose_2d::Header pose = robot_pose_2d::make_header(robot_pose_2d::TypeEnum::ROBOT_POSE_2_D, stamp);
+        CHECK(pose.get_metamodel() == robot_pose_2d::MsgMetamodel::ROPOD_MSG_SCHEMA_JSON);
+        CHECK(pose.get_type() == robot_pose_2d::TypeEnum::ROBOT_POSE_2_D);
+        check_generated_msg_id(pose.get_msg_id());
+        CHECK(pose.get_timestamp() && *pose.get_timestamp() == stamp);
+
+        // fresh ids from every thread, none repeated
+        std::set<Uuid> ids;
+        std::mutex mutex;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&] {
+                std::vector<Uuid> generated;
+                for (int i = 0; i < 2000; i++) generated.push_back(msg::make_header("X").get_msg_id());
+                std::lock_guard<std::mutex> lock(mutex);
+                ids.insert(generated.begin(), generated.end());
+            });
+        }
+        for (std::thread & thread : threads) thread.join();
+        CHECK(ids.size() == 8000);
+        for (const Uuid & id : ids) check_generated_msg_id(id);
+    }
+
+    void test_emitter_time_stamp_form() {
+        std::string text = pose_text;
+        text.replace(text.find("1521626403.125"), 14, "\"2019-01-01T10:00:00.000+02:00\"");
+        const RopodRobotPose2DSchema prototype = decode<RopodRobotPose2DSchema>(text);
+        RopodRobotPose2DSchemaEmitter emitter(prototype);
+        const Pose2D & pose = prototype.get_payload().get_pose();
+        CHECK(emitter.emit(prototype.get_header().get_msg_id(), *prototype.get_header().get_timestamp(), pose.get_x(), pose.get_y(), pose.get_theta(), prototype.get_payload().get_timestamp()) == text);
+
+        const RopodRobotPose2DSchema stamped = decode<RopodRobotPose2DSchema>(emitter.emit(1, 2, 3, prototype.get_payload().get_timestamp()));
+        const Instant & now = *stamped.get_header().get_timestamp();
+        CHECK(now.is_text() && now.get_offset() == 120 && now.get_fraction_digits() == 3);
+        CHECK(now > *prototype.get_header().get_timestamp());
+    }
+
+    void test_instant_formatter() {
+        InstantFormatter formatter;
+        UuidGenerator random(7);
+        char expected[Instant::max_text_length];
+        char actual[Instant::max_text_length];
+        int64_t nanoseconds = (1546300800 - 90) * INT64_C(1000000000);
+        for (int i = 0; i < 10000; i++) {
+            nanoseconds += static_cast<int64_t>(random.next().get_low() % 3000000000u);
+            Instant x(nanoseconds, true);
+            if (i % 3 == 1) x.set_offset(static_cast<int>(random.next().get_high() % 2879) - 1439);
+            if (i % 5 == 2) x.set_fraction_digits(static_cast<int>(random.next().get_high() % 10));
+            const size_t length = x.format(expected);
+            CHECK(formatter.format(x, actual) == length && std::memcmp(actual, expected, length) == 0);
+        }
+    }
+
+    void test_double_notation() {
+        std::mt19937_64 random(3);
+        RopodRobotPose2DSchema pose = decode<RopodRobotPose2DSchema>(pose_text);
+        Pose2D & position = pose.get_mutable_payload().get_mutable_pose();
+        for (int i = 0; i < 20000; i++) {
+            const double value = i == 0 ? 0.32467472 : std::uniform_real_distribution<double>(-1e3, 1e3)(random);
+            position.set_x(value);
+            position.set_y(std::round(value * 1000) / 1000);
+            position.set_theta(value * 1e-7);
+            const std::string text = encode(pose);
+            CHECK(text == json(pose).dump());
+            const std::string shortest = encode(pose, OptionalMembers::WRITE_NULL, DoubleNotation::SHORTEST);
+            CHECK(shortest.size() <= text.size());
+            const RopodRobotPose2DSchema decoded = decode<RopodRobotPose2DSchema>(shortest);
+            const Pose2D & read = decoded.get_payload().get_pose();
+            CHECK(read.get_x() == position.get_x() && read.get_y() == position.get_y() && read.get_theta() == position.get_theta());
+        }
+        position.set_x(0.32467472);
+        CHECK(encode(pose).find("0.32467472000000003") != std::string::npos);
+        CHECK(encode(pose, OptionalMembers::WRITE_NULL, DoubleNotation::SHORTEST).find("\"x\":0.32467472,") != std::string::npos);
+    }
+
+    void test_decode_batch() {
+        const size_t count = 1000;
+        std::vector<std::string> texts;
+        std::vector<size_t> bad;
+        RopodRobotPose2DSchema pose = decode<RopodRobotPose2DSchema>(pose_text);
+        for (size_t i = 0; i < count; i++) {
+            pose.get_mutable_payload().get_mutable_pose().set_x(static_cast<double>(i) / 8);
+            pose.get_mutable_payload().set_robot_id(std::to_string(i % 5));
+            std::string text = encode(pose);
+            if (i % 7 == 3) text.resize(text.size() / 2);
+            else if (i % 11 == 5) text = replaced(text, "\"x\":", "\"x\":\"0\",\"_\":");
+            else if (i == count - 1) text = "{}";
+            else {
+                texts.push_back(std::move(text));
+                continue;
+            }
+            bad.push_back(i);
+            texts.push_back(std::move(text));
+        }
+        const std::string empty = encode(RopodRobotPose2DSchema());
+
+        for (const size_t threads : { size_t(1), size_t(2), size_t(std::max(1u, std::thread::hardware_concurrency())) }) {
+            WorkerPool pool(threads);
+            std::vector<RopodRobotPose2DSchema> out;
+            // the second batch reuses both the pool and the slots of the first
+            for (int batch = 0; batch < 2; batch++) {
+                const std::vector<BatchError> errors = decode_batch(texts, out, pool);
+                CHECK(out.size() == count);
+                CHECK(errors.size() == bad.size());
+                for (size_t i = 0; i < errors.size() && i < bad.size(); i++) {
+                    CHECK(errors[i].get_index() == bad[i]);
+                    CHECK(errors[i].get_error().get_kind() == try_decode<RopodRobotPose2DSchema>(texts[bad[i]]).error().get_kind());
+                }
+                for (size_t i = 0; i < out.size(); i++) {
+                    const Expected<RopodRobotPose2DSchema> expected = try_decode<RopodRobotPose2DSchema>(texts[i]);
+                    CHECK(encode(out[i]) == (expected ? encode(*expected) : empty));
+                }
+            }
+        }
+    }
+
+    void test_pipeline_order() {
+        const int robots = 8;
+        const int messages_per_robot = 300;
+        IngestPipeline pipeline(IngestStageOptions(2, 4, 16), IngestStageOptions(3, 4, 16), IngestStageOptions(1), IngestStageOptions(3, 4, 16));
+        std::mutex mutex;
+        std::vector<double> last(robots, -1);
+        size_t handled = 0, out_of_order = 0, rejected = 0, malformed = 0;
+        pipeline.get_dispatcher().on<RopodRobotPose2DSchema>([&](const RopodRobotPose2DSchema & pose) {
+            const int robot = std::atoi(pose.get_payload().get_robot_id().c_str());
+            std::lock_guard<std::mutex> lock(mutex);
+            if (pose.get_payload().get_pose().get_x() <= last[robot]) out_of_order++;
+            last[robot] = pose.get_payload().get_pose().get_x();
+            handled++;
+        });
+        pipeline.validate<RopodRobotPose2DSchema>([](const RopodRobotPose2DSchema & pose) {
+            if (pose.get_payload().get_pose().get_theta() > 100) throw std::invalid_argument("theta out of range");
+        });
+        pipeline.on_error([&](const IngestError & error) {
+            std::lock_guard<std::mutex> lock(mutex);
+            (error.get_stage() == IngestStage::VALIDATE ? rejected : malformed)++;
+        });
+
+        CHECK_THROWS(std::logic_error, pipeline.submit(pose_text, "0"));
+        pipeline.start();
+        CHECK(pipeline.is_running());
+        RopodRobotPose2DSchema pose = decode<RopodRobotPose2DSchema>(pose_text);
+        size_t expected = 0, expected_rejected = 0, expected_malformed = 0;
+        for (int i = 0; i < messages_per_robot; i++) {
+            for (int robot = 0; robot < robots; robot++) {
+                pose.get_mutable_payload().set_robot_id(std::to_string(robot));
+                pose.get_mutable_payload().get_mutable_pose().set_x(i);
+                pose.get_mutable_payload().get_mutable_pose().set_theta(i % 37 == 5 ? 700 : 1);
+                std::string text = encode(pose);
+                if (i % 37 == 5) expected_rejected++;
+                else if (i % 41 == 7) {
+                    text.resize(text.size() - 2);
+                    expected_malformed++;
+                } else expected++;
+                pipeline.submit(std::move(text), std::to_string(robot));
+            }
+        }
+        pipeline.stop();
+        CHECK(!pipeline.is_running());
+        CHECK(handled == expected && out_of_order == 0);
+        CHECK(rejected == expected_rejected && malformed == expected_malformed);
+        CHECK(pipeline.get_stats(IngestStage::FRAME).get_processed() == static_cast<uint64_t>(robots * messages_per_robot));
+        CHECK(pipeline.get_stats(IngestStage::DISPATCH).get_processed() == expected);
+        CHECK(pipeline.get_stats(IngestStage::DISPATCH).get_depth() == 0);
+        CHECK_THROWS(std::logic_error, pipeline.submit(pose_text, "0"));
+
+        pipeline.start();
+        CHECK(pipeline.get_stats(IngestStage::FRAME).get_processed() == 0);
+        pipeline.submit(pose_text, "3");
+        pipeline.stop();
+        CHECK(pipeline.get_stats(IngestStage::DISPATCH).get_processed() == 1 && handled == expected + 1);
+    }
+
+    void test_pipeline_throwing_handler() {
+        IngestPipeline pipeline(IngestStageOptions(1), IngestStageOptions(2), IngestStageOptions(1), IngestStageOptions(2));
+        std::mutex mutex;
+        size_t handled = 0;
+        std::vector<IngestError> errors;
+        pipeline.get_dispatcher().on<RopodRobotPose2DSchema>([&](const RopodRobotPose2DSchema & pose) {
+            if (pose.get_payload().get_pose().get_x() < 0) throw std::runtime_error("handler failed");
+            std::lock_guard<std::mutex> lock(mutex);
+            handled++;
+        });
+        pipeline.on_error([&](const IngestError & error) {
+            std::lock_guard<std::mutex> lock(mutex);
+            errors.push_back(error);
+        });
+
+        pipeline.start();
+        RopodRobotPose2DSchema pose = decode<RopodRobotPose2DSchema>(pose_text);
+        for (int i = 0; i < 100; i++) {
+            pose.get_mutable_payload().get_mutable_pose().set_x(i % 10 == 3 ? -1 : i);
+            pipeline.submit(encode(pose), std::to_string(i % 10));
+        }
+        pipeline.stop();
+        CHECK(handled == 90 && errors.size() == 10);
+        for (const IngestError & error : errors) {
+            CHECK(error.get_stage() == IngestStage::DISPATCH && error.get_key() == "3" && error.get_error().get_message() == "handler failed");
+        }
+        CHECK(pipeline.get_stats(IngestStage::DISPATCH).get_processed() == 100);
+    }
+
+    void test_generator_seed() {
+        for (uint64_t seed : {0u, 1u, 42u}) {
+            RopodTaskSchema a, b, c;
+            MessageGenerator(seed).generate(a);
+            MessageGenerator(seed).generate(b);
+            MessageGenerator(seed + 1).generate(c);
+            CHECK(encode(a) == encode(b));
+            CHECK(encode(a) != encode(c));
+            CHECK(a.get_header().get_msg_id() != UuidGenerator(seed).next());
+        }
+    }
+
+    /**
+     * Checks that the records of one message in an NDJSON and a PACKED corpus both decode as
+     * the class of x, to the message x was decoded to.
+     */
+    struct CorpusRecordCheck : boost::static_visitor<void> {
+        boost::string_view text;
+        boost::string_view packed;
+
+        template <typename T>
+        void operator()(const T & x) const {
+            const Expected<T> from_text = try_decode<T>(text.data(), text.size());
+            const Expected<T> from_packed = try_decode_packed<T>(reinterpret_cast<const uint8_t *>(packed.data()), packed.size());
+            CHECK(from_text && from_packed);
+            if (!from_text || !from_packed) return;
+            CHECK(encode(*from_text) == encode(x));
+            CHECK(encode(*from_packed) == encode(x));
+        }
+    };
+
+    void test_corpus() {
+        const size_t count = 400;
+        CorpusOptions options;
+        options.set_robots(5);
+        const auto corpus = [&](uint64_t seed, CorpusFormat format) {
+            CorpusGenerator generator(seed, options);
+            generator.add<RopodBlackBoxDataQuerySchema>();
+            generator.add<RopodBlackBoxLatestDataQuerySchema>();
+            generator.add<RopodBlackBoxLoggingCmdSchema>();
+            generator.add<RopodBlackBoxVariableQuerySchema>();
+            generator.add<RopodCmdSchema>();
+            generator.add<RopodComponentMonitorSchema>();
+            generator.add<RopodElevatorCmdSchema>();
+            generator.add<RopodElevatorStatusSchema>();
+            generator.add<RopodExperimentCancel>();
+            generator.add<RopodExperimentRequest>();
+            generator.add<RopodExperimentSmSchema>();
+            generator.add<RopodFmsElevatorSchema>();
+            generator.add<RopodMsgSchema>();
+            generator.add<RopodRobotPose2DSchema>();
+            generator.add<RopodTaskRequestSchema>();
+            generator.add<RopodTaskSchema>();
+            std::ostringstream out;
+            CHECK(generator.write(out, count, format) == out.str().size());
+            return out.str();
+        };
+        const std::string text = corpus(25, CorpusFormat::NDJSON);
+        const std::string packed = corpus(25, CorpusFormat::PACKED);
+        CHECK(corpus(25, CorpusFormat::NDJSON) == text);
+        CHECK(corpus(25, CorpusFormat::PACKED) == packed);
+        CHECK(corpus(26, CorpusFormat::NDJSON) != text);
+        CHECK(corpus(26, CorpusFormat::PACKED) != packed);
+
+        // the same seed gives the same messages in both formats
+        CorpusReader text_reader(text.data(), text.size(), CorpusFormat::NDJSON);
+        CorpusReader packed_reader(packed.data(), packed.size(), CorpusFormat::PACKED);
+        std::set<int> schemas;
+        size_t read = 0;
+        CorpusRecordCheck check;
+        while (text_reader.next(check.text)) {
+            CHECK(packed_reader.next(check.packed));
+            const Expected<Message> message = try_decode_message(check.text.data(), check.text.size());
+            CHECK(message);
+            if (!message) continue;
+            schemas.insert(message->which());
+            boost::apply_visitor(check, *message);
+            read++;
+        }
+        CHECK(read == count);
+        const size_t last = static_cast<size_t>(check.packed.data() - packed.data()) - 4;
+        CHECK(!packed_reader.next(check.packed));
+        CHECK(schemas.size() == 16);
+
+        // a record cut short in its size or in its bytes ends the corpus
+        for (const size_t size : { packed.size() - 1, last + 5, last + 2 }) {
+            CorpusReader reader(packed.data(), size, CorpusFormat::PACKED);
+            boost::string_view message;
+            size_t records = 0;
+            while (reader.next(message)) records++;
+            CHECK(records == count - 1);
+        }
+    }
+
+    /**
+     * Round-trips generated messages of T through encode and try_decode, the nlohmann path
+     * and encode with OptionalMembers::OMIT_ABSENT, for several seeds and shapes.
+     */
+    template <typename T>
+    void check_round_trip() {
+        MessageShape bare;
+        bare.set_optionals(false);
+        bare.set_debug_geometry(false);
+        bare.set_receivers(0);
+        MessageShape long_lists;
+        long_lists.set_list_length(7);
+        long_lists.set_json_depth(3);
+        for (const MessageShape & shape : { MessageShape(), bare, long_lists }) {
+            for (uint64_t seed = 0; seed < 8; seed++) {
+                T x;
+                MessageGenerator(seed, shape).generate(x);
+                const std::string text = encode(x);
+                CHECK(text == json(x).dump());
+
+                const Expected<T> decoded = try_decode<T>(text);
+                CHECK(decoded);
+                if (!decoded) {
+                    std::cerr << decoded.error().to_string() << std::endl;
+                    continue;
+                }
+                CHECK(encode(*decoded) == text);
+                CHECK(encode(json::parse(text).get<T>()) == text);
+
+                const Expected<T> omitted = try_decode<T>(encode(x, OptionalMembers::OMIT_ABSENT));
+                CHECK(omitted && encode(*omitted) == text);
+            }
+        }
+    }
+
+    void test_round_trip() {
+        check_round_trip<RopodBlackBoxDataQuerySchema>();
+        check_round_trip<RopodBlackBoxLatestDataQuerySchema>();
+        check_round_trip<RopodBlackBoxLoggingCmdSchema>();
+        check_round_trip<RopodBlackBoxVariableQuerySchema>();
+        check_round_trip<RopodCmdSchema>();
+        check_round_trip<RopodComponentMonitorSchema>();
+        check_round_trip<RopodElevatorCmdSchema>();
+        check_round_trip<RopodElevatorStatusSchema>();
+        check_round_trip<RopodExperimentCancel>();
+        check_round_trip<RopodExperimentRequest>();
+        check_round_trip<RopodExperimentSmSchema>();
+        check_round_trip<RopodFmsElevatorSchema>();
+        check_round_trip<RopodMsgSchema>();
+        check_round_trip<RopodRobotPose2DSchema>();
+        check_round_trip<RopodTaskRequestSchema>();
+        check_round_trip<RopodTaskSchema>();
+        check_round_trip<RopodUnitsSchema>();
+    }
+
+    /**
+     * Round-trips generated messages of T through MessagePack and CBOR.
+     */
+    template <typename T>
+    void check_binary_round_trip() {
+        MessageShape bare;
+        bare.set_optionals(false);
+        bare.set_debug_geometry(false);
+        bare.set_receivers(0);
+        for (const MessageShape & shape : { MessageShape(), bare }) {
+            for (uint64_t seed = 0; seed < 4; seed++) {
+                T x;
+                MessageGenerator(seed, shape).generate(x);
+                const std::string text = encode(x);
+                const std::vector<uint8_t> msgpack = encode_msgpack(x);
+                CHECK(json::from_msgpack(msgpack) == json(x));
+                CHECK(encode(decode_msgpack<T>(msgpack)) == text);
+                const std::vector<uint8_t> cbor = encode_cbor(x);
+                CHECK(json::from_cbor(cbor) == json(x));
+                CHECK(encode(decode_cbor<T>(cbor)) == text);
+            }
+        }
+    }
+
+    void test_binary_round_trip() {
+        check_binary_round_trip<RopodBlackBoxDataQuerySchema>();
+        check_binary_round_trip<RopodBlackBoxLatestDataQuerySchema>();
+        check_binary_round_trip<RopodBlackBoxLoggingCmdSchema>();
+        check_binary_round_trip<RopodBlackBoxVariableQuerySchema>();
+        check_binary_round_trip<RopodCmdSchema>();
+        check_binary_round_trip<RopodComponentMonitorSchema>();
+        check_binary_round_trip<RopodElevatorCmdSchema>();
+        check_binary_round_trip<RopodElevatorStatusSchema>();
+        check_binary_round_trip<RopodExperimentCancel>();
+        check_binary_round_trip<RopodExperimentRequest>();
+        check_binary_round_trip<RopodExperimentSmSchema>();
+        check_binary_round_trip<RopodFmsElevatorSchema>();
+        check_binary_round_trip<RopodMsgSchema>();
+        check_binary_round_trip<RopodRobotPose2DSchema>();
+        check_binary_round_trip<RopodTaskRequestSchema>();
+        check_binary_round_trip<RopodTaskSchema>();
+        check_binary_round_trip<RopodUnitsSchema>();
+
+        const std::vector<uint8_t> msgpack = encode_msgpack(decode<RopodRobotPose2DSchema>(pose_text));
+        CHECK_THROWS(json::exception, decode_msgpack<RopodRobotPose2DSchema>(msgpack.data(), msgpack.size() / 2));
+    }
+
+    /**
+     * Round-trips generated messages of T through the packed format and the JSON bridge.
+     */
+    template <typename T>
+    void check_packed_round_trip() {
+        MessageShape bare;
+        bare.set_optionals(false);
+        bare.set_debug_geometry(false);
+        bare.set_receivers(0);
+        for (const MessageShape & shape : { MessageShape(), bare }) {
+            for (uint64_t seed = 0; seed < 8; seed++) {
+                T x;
+                MessageGenerator(seed, shape).generate(x);
+                const std::string text = encode(x);
+                const std::vector<uint8_t> bytes = encode_packed(x);
+                CHECK(peek_packed_schema(bytes.data(), bytes.size()) == PackedSchema<T>::tag);
+
+                const Expected<T> decoded = try_decode_packed<T>(bytes);
+                CHECK(decoded && encode(*decoded) == text);
+                CHECK(json_to_packed<T>(text) == bytes);
+                CHECK(packed_to_json<T>(bytes) == text);
+                CHECK(packed_to_json<T>(bytes, OptionalMembers::OMIT_ABSENT) == encode(x, OptionalMembers::OMIT_ABSENT));
+
+                // every strict prefix is rejected, as is trailing data
+                for (size_t size = 0; size < bytes.size(); size++) CHECK(!try_decode_packed<T>(bytes.data(), size));
+                std::vector<uint8_t> longer = bytes;
+                longer.push_back(0);
+                CHECK(!try_decode_packed<T>(longer));
+            }
+        }
+    }
+
+    void test_packed_round_trip() {
+        check_packed_round_trip<RopodBlackBoxDataQuerySchema>();
+        check_packed_round_trip<RopodBlackBoxLatestDataQuerySchema>();
+        check_packed_round_trip<RopodBlackBoxLoggingCmdSchema>();
+        check_packed_round_trip<RopodBlackBoxVariableQuerySchema>();
+        check_packed_round_trip<RopodCmdSchema>();
+        check_packed_round_trip<RopodComponentMonitorSchema>();
+        check_packed_round_trip<RopodElevatorCmdSchema>();
+        check_packed_round_trip<RopodElevatorStatusSchema>();
+        check_packed_round_trip<RopodExperimentCancel>();
+        check_packed_round_trip<RopodExperimentRequest>();
+        check_packed_round_trip<RopodExperimentSmSchema>();
+        check_packed_round_trip<RopodFmsElevatorSchema>();
+        check_packed_round_trip<RopodMsgSchema>();
+        check_packed_round_trip<RopodRobotPose2DSchema>();
+        check_packed_round_trip<RopodTaskRequestSchema>();
+        check_packed_round_trip<RopodTaskSchema>();
+        check_packed_round_trip<RopodUnitsSchema>();
+    }
+
+    void test_packed_bridge() {
+        const std::string text = pose_text;
+        const std::vector<uint8_t> bytes = json_to_packed<RopodRobotPose2DSchema>(text);
+        CHECK(packed_to_json<RopodRobotPose2DSchema>(bytes) == text);
+        CHECK(decode_packed<RopodRobotPose2DSchema>(bytes).get_payload().get_robot_id() == "robotId_3");
+
+        // not the canonical form: whitespace and member order are not kept
+        const std::string spaced = replaced(text, "\"x\":8.751,\"y\":10.001", "\"y\": 10.001, \"x\": 8.751");
+        CHECK(json_to_packed<RopodRobotPose2DSchema>(spaced) == bytes);
+        CHECK(packed_to_json<RopodRobotPose2DSchema>(json_to_packed<RopodRobotPose2DSchema>(spaced)) == text);
+
+        CHECK_THROWS(JsonDecodeException, json_to_packed<RopodRobotPose2DSchema>(text.substr(0, 100)));
+        CHECK_THROWS(PackedDecodeException, packed_to_json<RopodTaskSchema>(bytes));
+        const Expected<RopodTaskSchema> task = try_decode_packed<RopodTaskSchema>(bytes);
+        CHECK(!task);
+        if (!task) CHECK(task.error().get_kind() == DecodeErrorKind::TYPE_MISMATCH && task.error().get_path() == "" && task.error().get_offset() == 2);
+    }
+
+    void test_view() {
+        const std::vector<uint8_t> bytes = json_to_packed<RopodRobotPose2DSchema>(pose_text);
+        const Expected<RopodRobotPose2DSchemaView> view = try_view_packed<RopodRobotPose2DSchema>(bytes);
+        CHECK(view);
+        if (!view) return;
+        CHECK(view->get_header().get_msg_id().to_string() == "5b6c8f0e-9b1d-4c4e-8d4a-2f0b1c3d4e01");
+        CHECK(view->get_header().get_type() == robot_pose_2d::TypeEnum::ROBOT_POSE_2_D);
+        CHECK(view->get_header().get_receiver_ids() && view->get_header().get_receiver_ids()->size() == 1);
+        CHECK(view->get_header().get_receiver_ids() && (*view->get_header().get_receiver_ids())[0] == "receiverIds_2");
+        CHECK(view->get_header().get_timestamp() && view->get_header().get_timestamp()->get_nanoseconds() == INT64_C(1521626403125000000));
+        CHECK(view->get_payload().get_pose().get_x() == 8.751);
+        CHECK(view->get_payload().get_pose().get_theta() == 7.501);
+        CHECK(view->get_payload().get_robot_id() == "robotId_3");
+
+        // the view agrees with decode_packed for generated messages
+        for (uint64_t seed = 0; seed < 8; seed++) {
+            RopodTaskSchema task;
+            MessageGenerator(seed).generate(task);
+            const std::vector<uint8_t> task_bytes = encode_packed(task);
+            const RopodTaskSchemaView task_view = view_packed<RopodTaskSchema>(task_bytes);
+            const auto & payload = *task.get_payload();
+            CHECK(task_view.get_payload() && task_view.get_payload()->get_task_id() == payload.get_task_id());
+            if (!task_view.get_payload()) continue;
+            CHECK(task_view.get_payload()->get_actions().size() == payload.get_actions().size());
+            size_t i = 0;
+            for (const auto & action : task_view.get_payload()->get_actions()) {
+                CHECK(i < payload.get_actions().size() && action.get_action_id() == payload.get_actions()[i].get_action_id());
+                i++;
+            }
+            CHECK(i == payload.get_actions().size());
+        }
+
+        for (size_t size = 0; size < bytes.size(); size++) CHECK(!try_view_packed<RopodRobotPose2DSchema>(bytes.data(), size));
+        const Expected<RopodTaskSchemaView> task = try_view_packed<RopodTaskSchema>(bytes);
+        CHECK(!task);
+        if (!task) CHECK(task.error().get_kind() == DecodeErrorKind::TYPE_MISMATCH && task.error().get_path() == "" && task.error().get_offset() == 2);
+        CHECK_THROWS(PackedDecodeException, view_packed<RopodTaskSchema>(bytes));
+    }
+
+    /**
+     * Checks that generated messages of T decode as a Message of T's schema.
+     */
+    template <typename T>
+    void check_message_schema() {
+        for (uint64_t seed = 0; seed < 8; seed++) {
+            T x;
+            MessageGenerator(seed).generate(x);
+            const std::string text = encode(x);
+            const Expected<Message> message = try_decode_message(text);
+            CHECK(message && get_schema(*message) == MessageSchemaOf<T>::value);
+            if (message && get_schema(*message) == MessageSchemaOf<T>::value) CHECK(encode(boost::get<T>(*message)) == text);
+        }
+    }
+
+    void test_registry() {
+        check_message_schema<RopodBlackBoxDataQuerySchema>();
+        check_message_schema<RopodBlackBoxLatestDataQuerySchema>();
+        check_message_schema<RopodBlackBoxLoggingCmdSchema>();
+        check_message_schema<RopodBlackBoxVariableQuerySchema>();
+        check_message_schema<RopodCmdSchema>();
+        check_message_schema<RopodComponentMonitorSchema>();
+        check_message_schema<RopodElevatorCmdSchema>();
+        check_message_schema<RopodElevatorStatusSchema>();
+        check_message_schema<RopodExperimentCancel>();
+        check_message_schema<RopodExperimentRequest>();
+        check_message_schema<RopodExperimentSmSchema>();
+        check_message_schema<RopodFmsElevatorSchema>();
+        check_message_schema<RopodRobotPose2DSchema>();
+        check_message_schema<RopodTaskRequestSchema>();
+        check_message_schema<RopodTaskSchema>();
+
+        const std::pair<const char *, MessageSchema> types[] = {
+            { "ROBOT-POSE-2D", MessageSchema::ROBOT_POSE_2D },
+            { "TASK", MessageSchema::TASK },
+            { "ELEVATOR-CMD", MessageSchema::ELEVATOR_CMD },
+            { "ELEVATOR-CMD-REPLY", MessageSchema::ELEVATOR_CMD },
+            { "ELEVATOR-STATUS-QUERY", MessageSchema::ELEVATOR_STATUS },
+            { "ROBOT-ELEVATOR-CALL-REQUEST", MessageSchema::FMS_ELEVATOR },
+            { "ROBOT-ELEVATOR-CALL-REPLY", MessageSchema::FMS_ELEVATOR },
+            { "ROBOT-CALL-UPDATE", MessageSchema::FMS_ELEVATOR },
+            { "HEALTH-STATUS", MessageSchema::COMPONENT_MONITOR }
+        };
+        for (const auto & type : types) {
+            MessageSchema schema = MessageSchema::MSG;
+            CHECK(message_schema_from_type(type.first, schema) && schema == type.second);
+        }
+        for (const char * type : { "", "TASKS", "task", "ROBOT-POSE-2", "UNKNOWN-TYPE" }) {
+            MessageSchema schema = MessageSchema::MSG;
+            CHECK(!message_schema_from_type(type, schema) && schema == MessageSchema::MSG);
+        }
+
+        // types without a schema of their own decode as the generic envelope, and the header
+        // may come after the payload
+        const std::string unknown = replaced(pose_text, "ROBOT-POSE-2D", "UNKNOWN-TYPE");
+        const Expected<Message> envelope = try_decode_message(unknown);
+        CHECK(envelope && get_schema(*envelope) == MessageSchema::MSG);
+        const RopodRobotPose2DSchema pose = decode<RopodRobotPose2DSchema>(pose_text);
+        const std::string reordered = "{\"payload\":" + json(pose.get_payload()).dump() + ",\"header\":" + json(pose.get_header()).dump() + "}";
+        const Message moved = decode_message(reordered);
+        CHECK(get_schema(moved) == MessageSchema::ROBOT_POSE_2D && encode(boost::get<RopodRobotPose2DSchema>(moved)) == pose_text);
+
+        const Expected<Message> headless = try_decode_message("{\"payload\":{}}");
+        CHECK(!headless && headless.error().get_kind() == DecodeErrorKind::MISSING_KEY);
+        CHECK_THROWS(JsonDecodeException, decode_message(replaced(pose_text, "\"x\":8.751", "\"x\":null")));
+    }
+
+    void test_dispatcher() {
+        MessageDispatcher dispatcher;
+        std::vector<std::string> calls;
+        std::vector<DecodeError> errors;
+        dispatcher.on<RopodRobotPose2DSchema>([&](const RopodRobotPose2DSchema & pose) { calls.push_back(pose.get_payload().get_robot_id()); });
+        dispatcher.on<RopodTaskSchema>([&](const RopodTaskSchema &) { calls.push_back("task"); });
+        dispatcher.on_error([&](const DecodeError & error) { errors.push_back(error); });
+        CHECK(dispatcher.handles(MessageSchema::ROBOT_POSE_2D) && dispatcher.handles(MessageSchema::TASK));
+        CHECK(!dispatcher.handles(MessageSchema::MSG) && !dispatcher.handles(MessageSchema::ELEVATOR_CMD));
+
+        RopodTaskSchema task;
+        MessageGenerator(3).generate(task);
+        RopodElevatorCmdSchema elevator;
+        MessageGenerator(3).generate(elevator);
+        CHECK(dispatcher.dispatch(pose_text));
+        CHECK(dispatcher.dispatch(encode(task)));
+        CHECK(!dispatcher.dispatch(encode(elevator)));
+        CHECK(!dispatcher.dispatch(replaced(pose_text, "ROBOT-POSE-2D", "UNKNOWN-TYPE")));
+        CHECK(calls == std::vector<std::string>({ "robotId_3", "task" }));
+        CHECK(errors.empty());
+
+        // a type is handled by the schema it maps to, and messages are only decoded if handled
+        dispatcher.on<RopodElevatorCmdSchema>([&](const RopodElevatorCmdSchema &) { calls.push_back("elevator"); });
+        CHECK(dispatcher.dispatch(encode(elevator)));
+        CHECK(dispatcher.handle(decode_message(encode(elevator))));
+        CHECK(!dispatcher.handle(decode_message(replaced(pose_text, "ROBOT-POSE-2D", "UNKNOWN-TYPE"))));
+        CHECK(calls.size() == 4 && calls[2] == "elevator" && calls[3] == "elevator");
+
+        CHECK(!dispatcher.dispatch(std::string(pose_text).substr(0, 20)));
+        CHECK(!dispatcher.dispatch(replaced(pose_text, "\"x\":8.751", "\"x\":\"8.7\"")));
+        CHECK(calls.size() == 4 && errors.size() == 2);
+        if (errors.size() == 2) {
+            CHECK(errors[0].get_kind() == DecodeErrorKind::SYNTAX_ERROR && errors[0].get_path() == "/header");
+            CHECK(errors[1].get_kind() == DecodeErrorKind::TYPE_MISMATCH && errors[1].get_path() == "/payload/pose/x");
+        }
+    }
+
+    struct Test {
+        const char * name;
+        void (*run)();
+    };
+
+    const Test tests[] = {
+        { "pattern", test_pattern },
+        { "enum_tables", test_enum_tables },
+        { "peek_header", test_peek_header },
+        { "lazy_decode", test_lazy_decode },
+        { "decode_errors", test_decode_errors },
+        { "int64_range", test_int64_range },
+        { "uuid_case", test_uuid_case },
+        { "instant_text", test_instant_text },
+        { "instant_members", test_instant_members },
+        { "instant_formatter", test_instant_formatter },
+        { "make_header", test_make_header },
+        { "emitter_time_stamp_form", test_emitter_time_stamp_form },
+        { "double_notation", test_double_notation },
+        { "decode_batch", test_decode_batch },
+        { "pipeline_order", test_pipeline_order },
+        { "pipeline_throwing_handler", test_pipeline_throwing_handler },
+        { "generator_seed", test_generator_seed },
+        { "corpus", test_corpus },
+        { "round_trip", test_round_trip },
+        { "binary_round_trip", test_binary_round_trip },
+        { "packed_round_trip", test_packed_round_trip },
+        { "packed_bridge", test_packed_bridge },
+        { "view", test_view },
+        { "registry", test_registry },
+        { "dispatcher", test_dispatcher }
+    };
+}
+
+int main(int argc, char ** argv) {
+    const char * filter = argc > 1 ? argv[1] : "";
+    for (const Test & test : tests) {
+        if (std::strstr(test.name, filter) == nullptr) continue;
+        const size_t before = failed_checks;
+        try {
+            test.run();
+        } catch (const std::exception & e) {
+            std::cerr << test.name << ": unexpected exception: " << e.what() << std::endl;
+            failed_checks++;
+        }
+        std::cout << (failed_checks == before ? "ok     " : "FAILED ") << test.name << std::endl;
+    }
+    return failed_checks == 0 ? 0 : 1;
+}